@@ -29,8 +29,9 @@ Grid_VN2D::Grid_VN2D(size_t gridSizeX, size_t gridSizeY, size_t hopRadius,
                      size_t numServersPerNetworkNode, size_t maxNumArriveEvents,
                      double maxSimTime, size_t numThreads, size_t distSeed,
                      int numSerialOoO_Execs, std::string traceFolderName,
-                     std::string distParamsFile)
-    : OoO_SimModel(maxSimTime, numThreads, distSeed, numSerialOoO_Execs, traceFolderName),
+                     std::string distParamsFile,
+                     const OoO_SimOptions& options)
+    : OoO_SimModel(maxSimTime, numThreads, distSeed, numSerialOoO_Execs, traceFolderName, options),
       _gridSizeX(gridSizeX), _gridSizeY(gridSizeY),
       _hopRadius(hopRadius), _numServersPerNetworkNode(numServersPerNetworkNode),
       _maxNumArriveEvents(maxNumArriveEvents) {
@@ -55,7 +56,7 @@ Grid_VN2D::Grid_VN2D(size_t gridSizeX, size_t gridSizeY, size_t hopRadius,
     << ", Max: " << _maxTransitTime << std::endl;
 
     // Create trace folder if needed
-    if (!fs::exists(_traceFolderName)) {
+    if (!_traceFolderName.empty() && !fs::exists(_traceFolderName)) {
         if (fs::create_directory(_traceFolderName)) {
             std::cout << "Folder '" << _traceFolderName << "' created successfully.\n";
         } else {
@@ -254,13 +255,13 @@ void Grid_VN2D::CreateEdges() {
             size_t departIdx = GetVertexIndex(x, y, 1);
 
             // Arrive -> Depart
-            _edges[arriveIdx].emplace_back(arriveIdx, departIdx, _minServiceTime);
+            _edges[arriveIdx].emplace_back(arriveIdx, departIdx, _minServiceTime, _serviceDelayClass);
 
             // Connect Depart to neighboring Arrive vertices
-            if (x > 0)              _edges[departIdx].emplace_back(departIdx, GetVertexIndex(x-1, y, 0), _minTransitTime); // West
-            if (x < _gridSizeX-1)   _edges[departIdx].emplace_back(departIdx, GetVertexIndex(x+1, y, 0), _minTransitTime); // East
-            if (y > 0)              _edges[departIdx].emplace_back(departIdx, GetVertexIndex(x, y-1, 0), _minTransitTime); // North
-            if (y < _gridSizeY-1)   _edges[departIdx].emplace_back(departIdx, GetVertexIndex(x, y+1, 0), _minTransitTime); // South
+            if (x > 0)              _edges[departIdx].emplace_back(departIdx, GetVertexIndex(x-1, y, 0), _minTransitTime, _transitDelayClass); // West
+            if (x < _gridSizeX-1)   _edges[departIdx].emplace_back(departIdx, GetVertexIndex(x+1, y, 0), _minTransitTime, _transitDelayClass); // East
+            if (y > 0)              _edges[departIdx].emplace_back(departIdx, GetVertexIndex(x, y-1, 0), _minTransitTime, _transitDelayClass); // North
+            if (y < _gridSizeY-1)   _edges[departIdx].emplace_back(departIdx, GetVertexIndex(x, y+1, 0), _minTransitTime, _transitDelayClass); // South
         }
     }
 }
@@ -276,9 +277,9 @@ void Grid_VN2D::InitEvents() {
     TriangularDist init_arrive_delays(_minIntraArrivalTime, _modeIntraArrivalTime, _maxIntraArrivalTime, _distSeed);
 
     for (size_t i = 0; i < _gridSizeX * _gridSizeY; i++) {
-        _initEvents.push_back(new OoO_Event(_arriveVertices[i],
-                                          init_arrive_delays.GenRV(),
-                                          nullptr));
+        _initEvents.Schedule(_arriveVertices[i].get(),
+                           init_arrive_delays.GenRV(),
+                           nullptr);
     }
 }
 
@@ -58,7 +58,7 @@ void Grid_VN2D_Arrive::IO_SVs(std::vector<std::vector<size_t>>& Is, std::vector<
     Os.push_back(output_SV_indices);
 }
 
-void Grid_VN2D_Arrive::Run(std::list<OoO_Event*>& newEvents, double simTime, std::shared_ptr<Entity> entity) {
+void Grid_VN2D_Arrive::Run(OoO_EventSink& newEvents, double simTime, const std::shared_ptr<Entity>& entity) {
     std::shared_ptr<Grid_VN2D_Packet> packet = std::dynamic_pointer_cast<Grid_VN2D_Packet>(entity);
 
     // Evaluate Conditions
@@ -102,15 +102,15 @@ void Grid_VN2D_Arrive::Run(std::list<OoO_Event*>& newEvents, double simTime, std
 
     // Schedule New Events
     if (!_atDestination && _serverAvailable) {
-        newEvents.push_back(new OoO_Event(_departVertex,
-                                        simTime + _serviceDelay->GenRV(),
-                                        packet));
+        newEvents.Schedule(_departVertex.get(),
+                         simTime + _serviceDelay->GenRV(),
+                         packet);
     }
 
     if (_intraArrival && ++_numIntraArriveEvents < _maxNumIntraArriveEvents) {
-        newEvents.push_back(new OoO_Event(shared_from_this(),
-                                        simTime + _intraArrivalDelay->GenRV(),
-                                        nullptr));
+        newEvents.Schedule(this,
+                         simTime + _intraArrivalDelay->GenRV(),
+                         nullptr);
     }
 
     // Trace
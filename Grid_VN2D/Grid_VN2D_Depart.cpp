@@ -79,7 +79,7 @@ void Grid_VN2D_Depart::PrintNeighborInfo() const {
     printf("==============================\n\n");
 }
 
-void Grid_VN2D_Depart::Run(std::list<OoO_Event*>& newEvents, double simTime, std::shared_ptr<Entity> entity) {
+void Grid_VN2D_Depart::Run(OoO_EventSink& newEvents, double simTime, const std::shared_ptr<Entity>& entity) {
     std::shared_ptr<Grid_VN2D_Packet> packet = std::dynamic_pointer_cast<Grid_VN2D_Packet>(entity);
 
     // Evaluate Conditions
@@ -206,14 +206,14 @@ void Grid_VN2D_Depart::Run(std::list<OoO_Event*>& newEvents, double simTime, std
 
     // Schedule New Events
     if (_packetInQueue) {
-        newEvents.push_back(new OoO_Event(shared_from_this(),
-                                          simTime + _serviceDelay->GenRV(),
-                                          queue_packet));
+        newEvents.Schedule(this,
+                           simTime + _serviceDelay->GenRV(),
+                           queue_packet);
     }
 
-    newEvents.push_back(new OoO_Event(_arriveVertices.at(dest_dir),
-                                      simTime + _transitDelay->GenRV(),
-                                      packet));
+    newEvents.Schedule(_arriveVertices.at(dest_dir).get(),
+                       simTime + _transitDelay->GenRV(),
+                       packet);
 
     // Trace
     std::string trace_string = std::to_string(simTime) + ", ";
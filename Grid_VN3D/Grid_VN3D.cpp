@@ -14,8 +14,9 @@ Grid_VN3D::Grid_VN3D(size_t gridSizeX, size_t gridSizeY, size_t gridSizeZ,
                      size_t numThreads, size_t distSeed,
                      int numSerialOoO_Execs,
                      std::string traceFolderName,
-                     std::string distParamsFile)
-    : OoO_SimModel(maxSimTime, numThreads, distSeed, numSerialOoO_Execs, traceFolderName),
+                     std::string distParamsFile,
+                     const OoO_SimOptions& options)
+    : OoO_SimModel(maxSimTime, numThreads, distSeed, numSerialOoO_Execs, traceFolderName, options),
       _gridSizeX(gridSizeX), _gridSizeY(gridSizeY), _gridSizeZ(gridSizeZ),
       _hopRadius(hopRadius), _numServersPerNetworkNode(numServersPerNetworkNode),
       _maxNumArriveEvents(maxNumArriveEvents) {
@@ -40,7 +41,7 @@ Grid_VN3D::Grid_VN3D(size_t gridSizeX, size_t gridSizeY, size_t gridSizeZ,
     << ", Max: " << _maxTransitTime << std::endl;
 
     // Create trace folder if needed
-    if (!fs::exists(_traceFolderName)) {
+    if (!_traceFolderName.empty() && !fs::exists(_traceFolderName)) {
         if (fs::create_directory(_traceFolderName)) {
             std::cout << "Folder '" << _traceFolderName << "' created successfully.\n";
         } else {
@@ -264,15 +265,15 @@ void Grid_VN3D::CreateEdges() {
                 size_t departIdx = GetVertexIndex(x, y, z, 1);
 
                 // Arrive -> Depart
-                _edges[arriveIdx].emplace_back(arriveIdx, departIdx, _minServiceTime);
+                _edges[arriveIdx].emplace_back(arriveIdx, departIdx, _minServiceTime, _serviceDelayClass);
 
                 // Connect Depart to neighboring Arrive vertices
-                if (x > 0)              _edges[departIdx].emplace_back(departIdx, GetVertexIndex(x-1, y, z, 0), _minTransitTime); // West
-                if (x < _gridSizeX-1)   _edges[departIdx].emplace_back(departIdx, GetVertexIndex(x+1, y, z, 0), _minTransitTime); // East
-                if (y > 0)              _edges[departIdx].emplace_back(departIdx, GetVertexIndex(x, y-1, z, 0), _minTransitTime); // North
-                if (y < _gridSizeY-1)   _edges[departIdx].emplace_back(departIdx, GetVertexIndex(x, y+1, z, 0), _minTransitTime); // South
-                if (z > 0)              _edges[departIdx].emplace_back(departIdx, GetVertexIndex(x, y, z-1, 0), _minTransitTime); // Down
-                if (z < _gridSizeZ-1)   _edges[departIdx].emplace_back(departIdx, GetVertexIndex(x, y, z+1, 0), _minTransitTime); // Up
+                if (x > 0)              _edges[departIdx].emplace_back(departIdx, GetVertexIndex(x-1, y, z, 0), _minTransitTime, _transitDelayClass); // West
+                if (x < _gridSizeX-1)   _edges[departIdx].emplace_back(departIdx, GetVertexIndex(x+1, y, z, 0), _minTransitTime, _transitDelayClass); // East
+                if (y > 0)              _edges[departIdx].emplace_back(departIdx, GetVertexIndex(x, y-1, z, 0), _minTransitTime, _transitDelayClass); // North
+                if (y < _gridSizeY-1)   _edges[departIdx].emplace_back(departIdx, GetVertexIndex(x, y+1, z, 0), _minTransitTime, _transitDelayClass); // South
+                if (z > 0)              _edges[departIdx].emplace_back(departIdx, GetVertexIndex(x, y, z-1, 0), _minTransitTime, _transitDelayClass); // Down
+                if (z < _gridSizeZ-1)   _edges[departIdx].emplace_back(departIdx, GetVertexIndex(x, y, z+1, 0), _minTransitTime, _transitDelayClass); // Up
             }
         }
     }
@@ -291,9 +292,9 @@ void Grid_VN3D::InitEvents() {
     size_t total_nodes = _gridSizeX * _gridSizeY * _gridSizeZ;
 
     for (size_t i = 0; i < total_nodes; i++) {
-        _initEvents.push_back(new OoO_Event(_arriveVertices[i],
-                                          init_arrive_delays.GenRV(),
-                                          nullptr));
+        _initEvents.Schedule(_arriveVertices[i].get(),
+                           init_arrive_delays.GenRV(),
+                           nullptr);
     }
 }
 
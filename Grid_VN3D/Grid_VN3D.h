@@ -20,7 +20,8 @@ public:
               size_t numThreads, size_t distSeed,
               int numSerialOoO_Execs,
               std::string traceFolderName,
-              std::string distParamsFile);
+              std::string distParamsFile,
+              const OoO_SimOptions& options);
 
     Grid_VN3D_NeighborInfo GetHopNeighborStructures(size_t x, size_t y, size_t z);
     void PrintMeanPacketNetworkTime() const;
@@ -39,6 +40,10 @@ private:
     double _minServiceTime, _modeServiceTime, _maxServiceTime;
     double _minTransitTime, _modeTransitTime, _maxTransitTime;
 
+    // Edge delay classes, one per delay parameter
+    static constexpr int _serviceDelayClass = 0;
+    static constexpr int _transitDelayClass = 1;
+
     // Grid parameters
     const size_t _gridSizeX;
     const size_t _gridSizeY;
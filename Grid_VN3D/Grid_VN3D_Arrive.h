@@ -28,7 +28,7 @@ public:
     OoO_SV<int>& getPacketQueueSV();
     void AddDepartVertex(std::shared_ptr<Grid_VN3D_Depart> departVertex);
     virtual void IO_SVs(std::vector<std::vector<size_t>>& Is, std::vector<std::vector<size_t>>& Os) override;
-    virtual void Run(std::list<OoO_Event*>& newEvents, double simTime, std::shared_ptr<Entity> entity) override;
+    virtual void Run(OoO_EventSink& newEvents, double simTime, const std::shared_ptr<Entity>& entity) override;
 
 private:
     const size_t _networkNodeID;
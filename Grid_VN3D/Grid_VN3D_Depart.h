@@ -25,7 +25,7 @@ public:
     void AddNeighborInfo(const Grid_VN3D_NeighborInfo& info);
     void AddArriveVertices(std::vector<std::shared_ptr<Grid_VN3D_Arrive>> arriveVertices);
     virtual void IO_SVs(std::vector<std::vector<size_t>>& Is, std::vector<std::vector<size_t>>& Os) override;
-    virtual void Run(std::list<OoO_Event*>& newEvents, double simTime, std::shared_ptr<Entity> entity) override;
+    virtual void Run(OoO_EventSink& newEvents, double simTime, const std::shared_ptr<Entity>& entity) override;
     void PrintNeighborInfo() const;
 
 private:
@@ -0,0 +1,76 @@
+#include "OoO_SimConfig.h"
+
+#include <omp.h>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <thread>
+#include <unistd.h>
+#include <sys/wait.h>
+
+// Precompute the ITL tables of a list of model input files into ITL_tables, ahead of a sweep.
+// Each input file is handled by its own process, as vertex numbering is global to a process;
+// up to jobs processes run at once and share the hardware threads between them.
+// With -check changes, no tables are cached: instead the ITL table that PublishITL maintains is checked
+// against MakeITL through rounds of that many random edge and SV changes and their undoing.
+int main(int argc, char* argv[])
+{
+    size_t jobs = 0;
+    size_t check_changes = 0;
+    std::vector<std::string> input_filenames;
+    for (int a=1; a<argc; a++) {
+        std::string arg = argv[a];
+        if ("-j" == arg && a + 1 < argc) {
+            jobs = std::stoul(argv[++a]);
+        } else if ("-check" == arg && a + 1 < argc) {
+            check_changes = std::stoul(argv[++a]);
+        } else {
+            input_filenames.push_back(arg);
+        }
+    }
+    if (input_filenames.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [-j jobs] [-check changes] input_file..." << std::endl;
+        return 1;
+    }
+
+    size_t num_hw_threads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+    if (0 == jobs) jobs = std::min(input_filenames.size(), num_hw_threads);
+    const int threads_per_job = static_cast<int>(std::max<size_t>(num_hw_threads / jobs, 1));
+
+    std::map<pid_t, std::string> running;
+    size_t num_failed = 0;
+    auto wait_for_one = [&]() {
+        int status = 0;
+        pid_t pid = wait(&status);
+        if (pid < 0) return;
+        if (!WIFEXITED(status) || 0 != WEXITSTATUS(status)) {
+            std::cerr << "Error: ITL " << (check_changes ? "check" : "generation") << " failed for " << running[pid] << std::endl;
+            num_failed++;
+        }
+        running.erase(pid);
+    };
+
+    for (const std::string& input_filename : input_filenames) {
+        if (running.size() == jobs) wait_for_one();
+        std::cout.flush();
+        pid_t pid = fork();
+        if (pid < 0) {
+            std::cerr << "Error: cannot start ITL generation for " << input_filename << std::endl;
+            num_failed++;
+        } else if (0 == pid) {
+            omp_set_num_threads(threads_per_job);
+            bool success = RunInputFile(input_filename, true, check_changes);
+            std::cout.flush();
+            _exit(success ? 0 : 1);
+        } else {
+            running[pid] = input_filename;
+        }
+    }
+    while (!running.empty()) wait_for_one();
+
+    printf("ITL tables %s for %zu of %zu input files\n", check_changes ? "checked" : "generated",
+           input_filenames.size() - num_failed, input_filenames.size());
+    return (0 == num_failed) ? 0 : 1;
+}
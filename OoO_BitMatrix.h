@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+// Rows of packed bitsets in one buffer, for word-parallel set algebra over vertex indices
+class OoO_BitMatrix {
+public:
+    OoO_BitMatrix(size_t numRows, size_t numBits)
+    : _numWords((numBits + 63) / 64), _words(numRows * _numWords, 0) {}
+
+    size_t getNumWords() const { return _numWords; }
+
+    uint64_t* Row(size_t row) { return &_words[row * _numWords]; }
+    const uint64_t* Row(size_t row) const { return &_words[row * _numWords]; }
+
+    void Set(size_t row, size_t bit) { Row(row)[bit / 64] |= uint64_t(1) << (bit % 64); }
+    bool Test(size_t row, size_t bit) const { return 0 != (Row(row)[bit / 64] & (uint64_t(1) << (bit % 64))); }
+
+    // Call visit(bit) for each bit set in the row, in increasing order
+    template <typename Visit>
+    static void ForEachSet(const uint64_t* row, size_t numWords, Visit&& visit) {
+        for (size_t w=0; w<numWords; w++) {
+            uint64_t bits = row[w];
+            while (0 != bits) {
+                visit(w * 64 + __builtin_ctzll(bits));
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    // Call visit(bit) for each bit set in both rows, in increasing order
+    template <typename Visit>
+    static void ForEachCommon(const uint64_t* first, const uint64_t* second, size_t numWords, Visit&& visit) {
+        for (size_t w=0; w<numWords; w++) {
+            uint64_t common = first[w] & second[w];
+            while (0 != common) {
+                visit(w * 64 + __builtin_ctzll(common));
+                common &= common - 1;
+            }
+        }
+    }
+
+private:
+    size_t _numWords;               // Words per row
+    std::vector<uint64_t> _words;
+};
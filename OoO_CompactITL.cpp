@@ -0,0 +1,127 @@
+#include "OoO_CompactITL.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+OoO_CompactITL::OoO_CompactITL()
+: _numVertices(0), _encoding(Fixed16), _scale(1), _numClamped(0)
+{}
+
+OoO_CompactITL::OoO_CompactITL(const OoO_ITLMatrix& ITL, Encoding encoding, float quantum)
+: _numVertices(ITL.size()), _encoding(encoding), _scale(1), _numClamped(0)
+{
+    const float never = std::numeric_limits<float>::max();
+    _codes.resize(_numVertices * _numVertices * BytesPerCode() + _gatherPadding);
+
+    if (Fixed16 == encoding) {
+        // Finest power-of-two scale that fits the largest finite limit below the "never" code;
+        // every code times the scale is then exact in float
+        float max_limit = 0;
+        for (size_t j=0; j<_numVertices; j++) {
+            const float* j_limits = ITL.Row(j);
+            for (size_t k=0; k<_numVertices; k++) {
+                if (j_limits[k] < never) max_limit = std::max(max_limit, j_limits[k]);
+            }
+        }
+        int exponent = 0;
+        if (max_limit > 0) {
+            exponent = static_cast<int>(std::floor(std::log2((_neverCode16 - 1) / static_cast<double>(max_limit))));
+            exponent = std::min(exponent, 24);
+        }
+        _scale = std::ldexp(1.0f, -exponent);
+
+        for (size_t j=0; j<_numVertices; j++) {
+            const float* j_limits = ITL.Row(j);
+            uint16_t* j_codes = reinterpret_cast<uint16_t*>(&_codes[j * _numVertices * 2]);
+            for (size_t k=0; k<_numVertices; k++) {
+                if (never == j_limits[k]) {
+                    j_codes[k] = _neverCode16;
+                    continue;
+                }
+                double code = std::floor(std::ldexp(static_cast<double>(j_limits[k]), exponent));
+                if (code > _neverCode16 - 1) {
+                    code = _neverCode16 - 1;
+                    _numClamped++;
+                }
+                j_codes[k] = static_cast<uint16_t>(code);
+            }
+        }
+        return;
+    }
+
+    if (!(quantum > 0)) {
+        std::cerr << "Error: the quantum8 ITL encoding needs a positive delay quantum" << std::endl;
+        exit(1);
+    }
+    _scale = quantum;
+
+    // Limit of each code, rounded down to float; the last code is "never"
+    _quantumLimits.resize(_neverCode8 + 1);
+    for (size_t code=0; code<_neverCode8; code++) {
+        double limit = code * static_cast<double>(quantum);
+        float limit_f = static_cast<float>(limit);
+        if (static_cast<double>(limit_f) > limit) limit_f = std::nextafter(limit_f, 0.0f);
+        _quantumLimits[code] = limit_f;
+    }
+    _quantumLimits[_neverCode8] = never;
+
+    for (size_t j=0; j<_numVertices; j++) {
+        const float* j_limits = ITL.Row(j);
+        uint8_t* j_codes = &_codes[j * _numVertices];
+        for (size_t k=0; k<_numVertices; k++) {
+            if (never == j_limits[k]) {
+                j_codes[k] = _neverCode8;
+                continue;
+            }
+            // Largest code whose limit does not exceed the float limit
+            double code = std::floor(j_limits[k] / static_cast<double>(quantum));
+            if (code > _neverCode8 - 1) {
+                code = _neverCode8 - 1;
+                _numClamped++;
+            }
+            while (code > 0 && _quantumLimits[static_cast<size_t>(code)] > j_limits[k]) code--;
+            j_codes[k] = static_cast<uint8_t>(code);
+        }
+    }
+}
+
+bool OoO_CompactITL::ParseEncoding(const std::string& name, Encoding& encoding)
+{
+    if ("fixed16" == name) {
+        encoding = Fixed16;
+        return true;
+    }
+    if ("quantum8" == name) {
+        encoding = Quantum8;
+        return true;
+    }
+    return false;
+}
+
+OoO_CompactITL OoO_CompactITL::Transposed() const
+{
+    OoO_CompactITL transposed(*this);
+    const size_t bytes = BytesPerCode();
+    for (size_t j=0; j<_numVertices; j++) {
+        for (size_t k=0; k<_numVertices; k++) {
+            std::copy_n(&_codes[(j * _numVertices + k) * bytes], bytes, &transposed._codes[(k * _numVertices + j) * bytes]);
+        }
+    }
+    return transposed;
+}
+
+OoO_DependentPairs::OoO_DependentPairs(const OoO_CompactITL& ITL)
+: _offsets(ITL.size() + 1, 0)
+{
+    for (size_t k=0; k<ITL.size(); k++) {
+        for (size_t j=0; j<ITL.size(); j++) {
+            float limit = ITL(j, k);
+            if (limit < std::numeric_limits<float>::max()) {
+                _vertexIndices.push_back(static_cast<int>(j));
+                _limits.push_back(limit);
+            }
+        }
+        _offsets[k + 1] = _vertexIndices.size();
+    }
+}
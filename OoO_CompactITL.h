@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "OoO_ITLMatrix.h"
+
+// Dense ITL table stored as small integer codes, a half or a quarter of the float table. Fixed16 holds
+// 16-bit fixed-point values with a power-of-two scale, Quantum8 holds 8-bit multiples of the model's
+// delay quantum. The largest code of each encoding means "never" (FLT_MAX in the float table). Codes
+// round limits down, and limits too large for the code range are clamped down, so an event the float
+// table blocks is never found ready.
+class OoO_CompactITL {
+public:
+    enum Encoding { Fixed16, Quantum8 };
+    static constexpr uint16_t _neverCode16 = UINT16_MAX;
+    static constexpr uint8_t _neverCode8 = UINT8_MAX;
+
+    OoO_CompactITL();
+
+    // Quantum8 needs the delay quantum; Fixed16 picks its scale from the largest finite limit
+    OoO_CompactITL(const OoO_ITLMatrix& ITL, Encoding encoding, float quantum = 0);
+
+    // Encoding named by the itl_encoding option; false for "float" or an unknown name
+    static bool ParseEncoding(const std::string& name, Encoding& encoding);
+
+    size_t size() const { return _numVertices; }
+    Encoding getEncoding() const { return _encoding; }
+    size_t getNumClamped() const { return _numClamped; }   // Finite limits lowered to the largest code
+
+    // Decoded limit, exact in float, or FLT_MAX for "never"
+    float operator()(size_t j, size_t k) const {
+        if (Fixed16 == _encoding) return Decode16(Codes16(j)[k]);
+        return _quantumLimits[Codes8(j)[k]];
+    }
+
+    const uint16_t* Codes16(size_t j) const { return reinterpret_cast<const uint16_t*>(&_codes[j * _numVertices * 2]); }
+    const uint8_t* Codes8(size_t j) const { return &_codes[j * _numVertices]; }
+
+    float getScale() const { return _scale; }                              // Fixed16: limit = code * scale
+    const float* getQuantumLimits() const { return _quantumLimits.data(); } // Quantum8: limit of each code
+
+    float Decode16(uint16_t code) const {
+        return (_neverCode16 == code) ? std::numeric_limits<float>::max() : code * _scale;
+    }
+
+    OoO_CompactITL Transposed() const;
+
+private:
+    // Codes are read as 32-bit words by the gather kernels, so the buffer ends with this much padding
+    static constexpr size_t _gatherPadding = 4;
+
+    size_t BytesPerCode() const { return (Fixed16 == _encoding) ? 2 : 1; }
+
+    size_t _numVertices;
+    Encoding _encoding;
+    float _scale;
+    std::vector<float> _quantumLimits;  // 256 entries, the last one FLT_MAX
+    std::vector<uint8_t> _codes;        // Row-major codes
+    size_t _numClamped;
+};
@@ -0,0 +1,497 @@
+#include "OoO_EventQueue.h"
+
+#include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+std::unique_ptr<OoO_EventQueue> MakeEventQueue(const std::string& backend)
+{
+    if ("multiset" == backend) return std::make_unique<OoO_MultisetQueue>();
+    if ("calendar" == backend) return std::make_unique<OoO_CalendarQueue>();
+    if ("ladder" == backend) return std::make_unique<OoO_LadderQueue>();
+    if ("heap" == backend) return std::make_unique<OoO_HeapQueue>();
+
+    std::cerr << "Error: unknown event set backend '" << backend << "' (expected multiset, calendar, ladder or heap)" << std::endl;
+    exit(1);
+}
+
+const std::vector<OoO_Event*>& OoO_EventQueue::Ordered()
+{
+    if (!_orderedValid) {
+        _ordered.clear();
+        _ordered.reserve(Size());
+        FillOrdered(_ordered);
+        _orderedValid = true;
+    }
+    return _ordered;
+}
+
+void OoO_EventQueue::NotFound(const OoO_Event* event)
+{
+    // Skipping the erase would leave a pooled event in the queue after it is recycled
+    std::cerr << "Error: event queue has no pending event at time " << event->getTime()
+              << " (vertex " << event->getVertexIndex() << ", sequence " << event->getSequenceNum() << ")" << std::endl;
+    std::abort();
+}
+
+// Multiset
+
+void OoO_MultisetQueue::InsertEvent(OoO_Event* event)
+{
+    _E.insert(event);
+}
+
+void OoO_MultisetQueue::EraseEvent(OoO_Event* event)
+{
+    // Events with an equal key sit together, find this one among them
+    for (auto it = _E.lower_bound(event); it != _E.end() && !_E.key_comp()(event, *it); it++) {
+        if (*it == event) {
+            _E.erase(it);
+            return;
+        }
+    }
+    NotFound(event);
+}
+
+void OoO_MultisetQueue::FillOrdered(std::vector<OoO_Event*>& ordered)
+{
+    ordered.insert(ordered.end(), _E.begin(), _E.end());
+}
+
+// d-ary heap
+
+void OoO_HeapQueue::Place(size_t pos, Entry&& entry)
+{
+    entry._event->setQueuePos(pos);
+    _heap[pos] = std::move(entry);
+}
+
+void OoO_HeapQueue::SiftUp(size_t pos)
+{
+    Entry entry = std::move(_heap[pos]);
+    while (pos > 0) {
+        size_t parent = (pos - 1) / _arity;
+        if (!Precedes(entry, _heap[parent])) break;
+        Place(pos, std::move(_heap[parent]));
+        pos = parent;
+    }
+    Place(pos, std::move(entry));
+}
+
+void OoO_HeapQueue::SiftDown(size_t pos)
+{
+    Entry entry = std::move(_heap[pos]);
+    while (true) {
+        size_t first_child = pos * _arity + 1;
+        if (first_child >= _heap.size()) break;
+
+        size_t last_child = std::min(first_child + _arity, _heap.size());
+        size_t min_child = first_child;
+        for (size_t child = first_child + 1; child < last_child; child++) {
+            if (Precedes(_heap[child], _heap[min_child])) min_child = child;
+        }
+        if (!Precedes(_heap[min_child], entry)) break;
+
+        Place(pos, std::move(_heap[min_child]));
+        pos = min_child;
+    }
+    Place(pos, std::move(entry));
+}
+
+void OoO_HeapQueue::InsertEvent(OoO_Event* event)
+{
+    _heap.emplace_back(event);
+    if (_backTimeValid && _heap.back()._time > _backTime) _backTime = _heap.back()._time;
+    SiftUp(_heap.size() - 1);
+}
+
+void OoO_HeapQueue::EraseEvent(OoO_Event* event)
+{
+    size_t pos = event->getQueuePos();
+    if (pos >= _heap.size() || _heap[pos]._event != event) NotFound(event);
+    if (_heap[pos]._time == _backTime) _backTimeValid = false;
+
+    // Move the last entry into the hole and restore the heap in whichever direction it violates
+    if (pos + 1 != _heap.size()) {
+        Place(pos, std::move(_heap.back()));
+        _heap.pop_back();
+        if (pos > 0 && Precedes(_heap[pos], _heap[(pos - 1) / _arity])) {
+            SiftUp(pos);
+        } else {
+            SiftDown(pos);
+        }
+    } else {
+        _heap.pop_back();
+    }
+}
+
+double OoO_HeapQueue::BackTime() const
+{
+    // The latest event is a leaf; rescan only after it was removed
+    if (!_backTimeValid) {
+        _backTime = _heap.back()._time;
+        for (size_t pos = (_heap.size() - 1) / _arity; pos < _heap.size(); pos++) {
+            _backTime = std::max(_backTime, _heap[pos]._time);
+        }
+        _backTimeValid = true;
+    }
+    return _backTime;
+}
+
+void OoO_HeapQueue::FillOrdered(std::vector<OoO_Event*>& ordered)
+{
+    std::vector<const Entry*> sorted;
+    sorted.reserve(_heap.size());
+    for (const Entry& entry : _heap) {
+        sorted.push_back(&entry);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const Entry* first, const Entry* second) { return Precedes(*first, *second); });
+    for (const Entry* entry : sorted) {
+        ordered.push_back(entry->_event);
+    }
+}
+
+// Calendar queue
+
+OoO_CalendarQueue::OoO_CalendarQueue()
+: _buckets(2), _width(1.0), _numEvents(0), _currentDay(0), _frontBucket(0), _frontValid(false),
+  _backTime(0), _backTimeValid(false)
+{}
+
+long long OoO_CalendarQueue::Day(double time) const
+{
+    return static_cast<long long>(std::floor(time / _width));
+}
+
+void OoO_CalendarQueue::InsertEvent(OoO_Event* event)
+{
+    Entry entry(event);
+    double time = entry._time;
+    long long day = Day(time);
+    std::vector<Entry>& bucket = _buckets[BucketOf(day)];
+    bucket.insert(std::upper_bound(bucket.begin(), bucket.end(), entry, Precedes), std::move(entry));
+
+    if (0 == _numEvents || day < _currentDay) _currentDay = day;
+    if (_backTimeValid && time > _backTime) _backTime = time;
+    _numEvents++;
+    _frontValid = false;
+
+    if (_numEvents > 2 * _buckets.size()) Resize(2 * _buckets.size());
+}
+
+void OoO_CalendarQueue::EraseEvent(OoO_Event* event)
+{
+    std::vector<Entry>& bucket = _buckets[BucketOf(Day(event->getTime()))];
+    auto it = std::lower_bound(bucket.begin(), bucket.end(), event, [](const Entry& entry, const OoO_Event* key) {
+        if (entry._time != key->getTime()) return entry._time < key->getTime();
+        if (entry._vertexIndex != key->getVertexIndex()) return entry._vertexIndex < key->getVertexIndex();
+        return entry._sequenceNum < key->getSequenceNum();
+    });
+    if (it == bucket.end() || it->_event != event) NotFound(event);
+
+    bucket.erase(it);
+    _numEvents--;
+    _frontValid = false;
+    if (event->getTime() == _backTime) _backTimeValid = false;
+
+    if (_buckets.size() > 2 && _numEvents < _buckets.size() / 2) Resize(_buckets.size() / 2);
+}
+
+void OoO_CalendarQueue::FindFront()
+{
+    // Scan one year of days from the current day for a bucket whose head falls on that day
+    for (size_t i=0; i<_buckets.size(); i++) {
+        long long day = _currentDay + i;
+        size_t bucket_index = BucketOf(day);
+        const std::vector<Entry>& bucket = _buckets[bucket_index];
+        if (!bucket.empty() && Day(bucket.front()._time) == day) {
+            _currentDay = day;
+            _frontBucket = bucket_index;
+            _frontValid = true;
+            return;
+        }
+    }
+
+    // Nothing within a year, take the earliest bucket head directly
+    const Entry* front = nullptr;
+    for (size_t bucket_index=0; bucket_index<_buckets.size(); bucket_index++) {
+        const std::vector<Entry>& bucket = _buckets[bucket_index];
+        if (!bucket.empty() && (nullptr == front || Precedes(bucket.front(), *front))) {
+            front = &bucket.front();
+            _frontBucket = bucket_index;
+        }
+    }
+    _currentDay = Day(front->_time);
+    _frontValid = true;
+}
+
+OoO_Event* OoO_CalendarQueue::Front()
+{
+    if (!_frontValid) FindFront();
+    return _buckets[_frontBucket].front()._event;
+}
+
+double OoO_CalendarQueue::BackTime() const
+{
+    // Rescan the bucket tails only after the latest event was removed
+    if (!_backTimeValid) {
+        _backTime = -std::numeric_limits<double>::infinity();
+        for (const std::vector<Entry>& bucket : _buckets) {
+            if (!bucket.empty()) _backTime = std::max(_backTime, bucket.back()._time);
+        }
+        _backTimeValid = true;
+    }
+    return _backTime;
+}
+
+void OoO_CalendarQueue::Resize(size_t numBuckets)
+{
+    std::vector<Entry> entries;
+    entries.reserve(_numEvents);
+    for (std::vector<Entry>& bucket : _buckets) {
+        for (Entry& entry : bucket) entries.push_back(std::move(entry));
+    }
+    std::sort(entries.begin(), entries.end(), Precedes);
+
+    // Day width of about three times the mean spacing of the earliest events
+    size_t num_samples = std::min<size_t>(entries.size(), 25);
+    if (num_samples > 1) {
+        double spacing = (entries[num_samples - 1]._time - entries[0]._time) / (num_samples - 1);
+        if (spacing > 0) _width = 3.0 * spacing;
+    }
+
+    // Entries arrive in order, so every bucket stays sorted
+    _buckets.assign(numBuckets, std::vector<Entry>());
+    for (Entry& entry : entries) {
+        _buckets[BucketOf(Day(entry._time))].push_back(std::move(entry));
+    }
+    if (!entries.empty()) _currentDay = Day(entries.front()._time);
+    _frontValid = false;
+}
+
+void OoO_CalendarQueue::FillOrdered(std::vector<OoO_Event*>& ordered)
+{
+    if (0 == _numEvents) return;
+    if (!_frontValid) FindFront();
+
+    // Walk the days in order, emitting each bucket's entries that fall on the current day
+    std::vector<size_t> cursors(_buckets.size(), 0);
+    long long day = _currentDay;
+    size_t num_empty_days = 0;
+    while (ordered.size() < _numEvents) {
+        size_t bucket_index = BucketOf(day);
+        const std::vector<Entry>& bucket = _buckets[bucket_index];
+        size_t& cursor = cursors[bucket_index];
+        bool emitted = false;
+        while (cursor < bucket.size() && Day(bucket[cursor]._time) == day) {
+            ordered.push_back(bucket[cursor++]._event);
+            emitted = true;
+        }
+        day++;
+
+        // After a whole empty year, skip ahead to the next remaining day
+        num_empty_days = emitted ? 0 : num_empty_days + 1;
+        if (num_empty_days == _buckets.size()) {
+            long long next_day = std::numeric_limits<long long>::max();
+            for (size_t i=0; i<_buckets.size(); i++) {
+                if (cursors[i] < _buckets[i].size()) next_day = std::min(next_day, Day(_buckets[i][cursors[i]]._time));
+            }
+            day = next_day;
+            num_empty_days = 0;
+        }
+    }
+}
+
+// Ladder queue
+
+OoO_LadderQueue::OoO_LadderQueue()
+: _topStart(-std::numeric_limits<double>::infinity()), _numEvents(0), _backTime(0), _backTimeValid(false)
+{}
+
+long OoO_LadderQueue::Rung::Index(double time, bool clampLow) const
+{
+    double index = std::floor((time - _start) / _width);
+    if (index >= static_cast<double>(_buckets.size())) return _buckets.size() - 1;
+    if (index < 0) return clampLow ? 0 : -1;
+    return static_cast<long>(index);
+}
+
+std::vector<OoO_LadderQueue::Entry>* OoO_LadderQueue::Locate(double time, bool& isBottom)
+{
+    isBottom = false;
+    if (time >= _topStart) return &_top;
+
+    // A rung's bucket just before its current one has been split into the next rung;
+    // earlier buckets have already been handed down to the bottom
+    for (size_t level=0; level<_rungs.size(); level++) {
+        Rung& rung = _rungs[level];
+        long index = rung.Index(time, level > 0);
+        if (index >= static_cast<long>(rung._current)) return &rung._buckets[index];
+        if (index != static_cast<long>(rung._current) - 1) break;
+    }
+
+    isBottom = true;
+    return &_bottom;
+}
+
+void OoO_LadderQueue::InsertEvent(OoO_Event* event)
+{
+    Entry entry(event);
+    double time = entry._time;
+    bool is_bottom;
+    std::vector<Entry>* container = Locate(time, is_bottom);
+    if (is_bottom) {
+        _bottom.insert(std::upper_bound(_bottom.begin(), _bottom.end(), entry, Precedes), std::move(entry));
+    } else {
+        Append(*container, std::move(entry));
+    }
+    if (_backTimeValid && time > _backTime) _backTime = time;
+    _numEvents++;
+}
+
+void OoO_LadderQueue::EraseEvent(OoO_Event* event)
+{
+    bool is_bottom;
+    std::vector<Entry>* container = Locate(event->getTime(), is_bottom);
+    if (is_bottom) {
+        // The bottom is sorted and its keys are unique
+        auto it = std::lower_bound(_bottom.begin(), _bottom.end(), Entry(event), Precedes);
+        if (it == _bottom.end() || it->_event != event) NotFound(event);
+        _bottom.erase(it);
+    } else {
+        // Top and rung buckets are unsorted: move the last entry into the hole
+        size_t pos = event->getQueuePos();
+        if (pos >= container->size() || (*container)[pos]._event != event) NotFound(event);
+        if (pos + 1 != container->size()) {
+            (*container)[pos] = std::move(container->back());
+            (*container)[pos]._event->setQueuePos(pos);
+        }
+        container->pop_back();
+    }
+    if (event->getTime() == _backTime) _backTimeValid = false;
+
+    // Start over from the top once empty, so the next events are not forced into the bottom
+    if (0 == --_numEvents) {
+        _top.clear();
+        _rungs.clear();
+        _bottom.clear();
+        _topStart = -std::numeric_limits<double>::infinity();
+    }
+}
+
+void OoO_LadderQueue::Append(std::vector<Entry>& container, Entry&& entry)
+{
+    entry._event->setQueuePos(container.size());
+    container.push_back(std::move(entry));
+}
+
+void OoO_LadderQueue::SpawnFromTop()
+{
+    double top_min = _top.front()._time;
+    double top_max = top_min;
+    for (const Entry& entry : _top) {
+        top_min = std::min(top_min, entry._time);
+        top_max = std::max(top_max, entry._time);
+    }
+
+    Rung rung;
+    rung._start = top_min;
+    rung._width = (top_max > top_min) ? (top_max - top_min) / _top.size() : 1.0;
+    rung._current = 0;
+    rung._buckets.resize(_top.size());
+    for (Entry& entry : _top) {
+        Append(rung._buckets[rung.Index(entry._time, true)], std::move(entry));
+    }
+    _top.clear();
+
+    // Everything from the old top now lies below the new top start
+    _topStart = rung._start + rung._width * rung._buckets.size();
+    if (_topStart <= top_max) _topStart = std::nextafter(top_max, std::numeric_limits<double>::infinity());
+    _rungs.push_back(std::move(rung));
+}
+
+void OoO_LadderQueue::Refill()
+{
+    while (_bottom.empty()) {
+        if (_rungs.empty()) SpawnFromTop();
+
+        Rung& rung = _rungs.back();
+        while (rung._current < rung._buckets.size() && rung._buckets[rung._current].empty()) rung._current++;
+        if (rung._current == rung._buckets.size()) {
+            _rungs.pop_back();
+            continue;
+        }
+
+        std::vector<Entry>& bucket = rung._buckets[rung._current];
+        if (bucket.size() > _bottomThreshold && _rungs.size() < _maxRungs) {
+            // Split a crowded bucket over a finer rung
+            Rung child;
+            child._start = rung._start + rung._width * rung._current;
+            child._width = rung._width / bucket.size();
+            child._current = 0;
+            child._buckets.resize(bucket.size());
+            for (Entry& entry : bucket) {
+                Append(child._buckets[child.Index(entry._time, true)], std::move(entry));
+            }
+            bucket.clear();
+            rung._current++;
+            _rungs.push_back(std::move(child));
+        } else {
+            _bottom = std::move(bucket);
+            bucket.clear();
+            std::sort(_bottom.begin(), _bottom.end(), Precedes);
+            rung._current++;
+        }
+    }
+}
+
+OoO_Event* OoO_LadderQueue::Front()
+{
+    if (_bottom.empty()) Refill();
+    return _bottom.front()._event;
+}
+
+double OoO_LadderQueue::BackTime() const
+{
+    if (_backTimeValid) return _backTime;
+
+    // Latest events sit in the top, else in the last occupied bucket of the coarsest rung
+    _backTimeValid = true;
+    _backTime = -std::numeric_limits<double>::infinity();
+    if (!_top.empty()) {
+        for (const Entry& entry : _top) _backTime = std::max(_backTime, entry._time);
+        return _backTime;
+    }
+    for (const Rung& rung : _rungs) {
+        for (size_t i = rung._buckets.size(); i-- > rung._current; ) {
+            if (rung._buckets[i].empty()) continue;
+            for (const Entry& entry : rung._buckets[i]) _backTime = std::max(_backTime, entry._time);
+            return _backTime;
+        }
+    }
+    _backTime = _bottom.back()._time;
+    return _backTime;
+}
+
+void OoO_LadderQueue::FillOrdered(std::vector<OoO_Event*>& ordered)
+{
+    for (const Entry& entry : _bottom) ordered.push_back(entry._event);
+
+    // Finer rungs hold earlier events than the rungs they were split from
+    std::vector<const Entry*> sorted;
+    auto append_sorted = [&ordered, &sorted](const std::vector<Entry>& entries) {
+        sorted.clear();
+        for (const Entry& entry : entries) sorted.push_back(&entry);
+        std::sort(sorted.begin(), sorted.end(), [](const Entry* first, const Entry* second) { return Precedes(*first, *second); });
+        for (const Entry* entry : sorted) ordered.push_back(entry->_event);
+    };
+    for (size_t level = _rungs.size(); level-- > 0; ) {
+        const Rung& rung = _rungs[level];
+        for (size_t i = rung._current; i < rung._buckets.size(); i++) {
+            append_sorted(rung._buckets[i]);
+        }
+    }
+    append_sorted(_top);
+}
@@ -0,0 +1,182 @@
+#pragma once
+
+#include <vector>
+#include <set>
+#include <memory>
+#include <string>
+
+#include "OoO_EventSet.h"
+
+// Pending-event-set backend. Events are kept in event-set order (timestamp, then vertex index,
+// then insertion order) and may be removed from anywhere, since out-of-order execution
+// retires events that are not at the front.
+class OoO_EventQueue {
+public:
+    virtual ~OoO_EventQueue() = default;
+
+    // Insert a pending event; its sequence number must already be assigned
+    void Insert(OoO_Event* event) { _orderedValid = false; InsertEvent(event); }
+
+    // Remove a pending event
+    void Erase(OoO_Event* event) { _orderedValid = false; EraseEvent(event); }
+
+    // Earliest pending event (queue must not be empty)
+    virtual OoO_Event* Front() = 0;
+
+    // Latest pending timestamp (queue must not be empty)
+    virtual double BackTime() const = 0;
+
+    virtual size_t Size() const = 0;
+    bool Empty() const { return 0 == Size(); }
+
+    // Pending events in event-set order, valid until the next Insert or Erase
+    const std::vector<OoO_Event*>& Ordered();
+
+protected:
+    // Cached ordering key, so backends compare without touching the event objects
+    struct Entry {
+        Entry(OoO_Event* event)
+        : _time(event->getTime()), _vertexIndex(event->getVertexIndex()),
+          _sequenceNum(event->getSequenceNum()), _event(event) {}
+        double _time;
+        int _vertexIndex;
+        size_t _sequenceNum;
+        OoO_Event* _event;
+    };
+    static bool Precedes(const Entry& first, const Entry& second) {
+        if (first._time != second._time) return first._time < second._time;
+        if (first._vertexIndex != second._vertexIndex) return first._vertexIndex < second._vertexIndex;
+        return first._sequenceNum < second._sequenceNum;
+    }
+
+    virtual void InsertEvent(OoO_Event* event) = 0;
+    virtual void EraseEvent(OoO_Event* event) = 0;
+    virtual void FillOrdered(std::vector<OoO_Event*>& ordered) = 0;
+
+    // An erased event must be pending; report the broken invariant and abort
+    [[noreturn]] static void NotFound(const OoO_Event* event);
+
+private:
+    std::vector<OoO_Event*> _ordered;   // Cached ordered snapshot
+    bool _orderedValid = false;         // Snapshot matches the queue contents
+};
+
+// Create a backend by name: multiset, calendar, ladder or heap
+std::unique_ptr<OoO_EventQueue> MakeEventQueue(const std::string& backend);
+
+// Red-black tree of event pointers (original event set)
+class OoO_MultisetQueue : public OoO_EventQueue {
+public:
+    OoO_Event* Front() override { return *_E.begin(); }
+    double BackTime() const override { return (*_E.rbegin())->getTime(); }
+    size_t Size() const override { return _E.size(); }
+
+protected:
+    void InsertEvent(OoO_Event* event) override;
+    void EraseEvent(OoO_Event* event) override;
+    void FillOrdered(std::vector<OoO_Event*>& ordered) override;
+
+private:
+    std::multiset<OoO_Event*, EventPtr_Compare> _E;
+};
+
+// Implicit d-ary min-heap over cached keys; each event records its heap position for arbitrary removal
+class OoO_HeapQueue : public OoO_EventQueue {
+public:
+    OoO_Event* Front() override { return _heap.front()._event; }
+    double BackTime() const override;
+    size_t Size() const override { return _heap.size(); }
+
+protected:
+    void InsertEvent(OoO_Event* event) override;
+    void EraseEvent(OoO_Event* event) override;
+    void FillOrdered(std::vector<OoO_Event*>& ordered) override;
+
+private:
+    static constexpr size_t _arity = 4;     // Children per node; half the depth of a binary heap
+
+    void SiftUp(size_t pos);
+    void SiftDown(size_t pos);
+    void Place(size_t pos, Entry&& entry);
+
+    std::vector<Entry> _heap;
+    mutable double _backTime = 0;               // Latest pending timestamp, when cached
+    mutable bool _backTimeValid = false;
+};
+
+// Calendar queue (Brown, 1988): timestamps hash into a ring of day-wide buckets, each kept sorted.
+// The bucket count doubles/halves with the queue size, and the day width is resampled from the
+// spacing of the earliest events.
+class OoO_CalendarQueue : public OoO_EventQueue {
+public:
+    OoO_CalendarQueue();
+
+    OoO_Event* Front() override;
+    double BackTime() const override;
+    size_t Size() const override { return _numEvents; }
+
+protected:
+    void InsertEvent(OoO_Event* event) override;
+    void EraseEvent(OoO_Event* event) override;
+    void FillOrdered(std::vector<OoO_Event*>& ordered) override;
+
+private:
+    long long Day(double time) const;
+    size_t BucketOf(long long day) const { return static_cast<size_t>(day) & (_buckets.size() - 1); }
+    void FindFront();
+    void Resize(size_t numBuckets);
+
+    std::vector<std::vector<Entry>> _buckets;   // Power-of-two ring of sorted buckets
+    double _width;                              // Time span of a bucket (one day)
+    size_t _numEvents;
+    long long _currentDay;                      // Day of the earliest pending event (lower bound)
+    size_t _frontBucket;                        // Bucket holding the earliest event, when cached
+    bool _frontValid;
+    mutable double _backTime;                   // Latest pending timestamp, when cached
+    mutable bool _backTimeValid;
+};
+
+// Ladder queue (Tang, Goh & Thng, 2005): unsorted top, rungs of unsorted buckets that are split
+// into finer rungs on demand, and a short sorted bottom from which events are taken. Events in the
+// top and rung buckets record their position there, so they are removed without a search.
+class OoO_LadderQueue : public OoO_EventQueue {
+public:
+    OoO_LadderQueue();
+
+    OoO_Event* Front() override;
+    double BackTime() const override;
+    size_t Size() const override { return _numEvents; }
+
+protected:
+    void InsertEvent(OoO_Event* event) override;
+    void EraseEvent(OoO_Event* event) override;
+    void FillOrdered(std::vector<OoO_Event*>& ordered) override;
+
+private:
+    static constexpr size_t _bottomThreshold = 50;  // Larger buckets are split into a new rung
+    static constexpr size_t _maxRungs = 8;
+
+    struct Rung {
+        double _start;                          // Timestamp at the start of bucket 0
+        double _width;                          // Bucket width
+        size_t _current;                        // Buckets before this one have been handed down
+        std::vector<std::vector<Entry>> _buckets;
+        long Index(double time, bool clampLow) const;
+    };
+
+    // Locate the container an event with this timestamp belongs to
+    std::vector<Entry>* Locate(double time, bool& isBottom);
+
+    // Add an entry to the top or a rung bucket, recording its position
+    static void Append(std::vector<Entry>& container, Entry&& entry);
+    void SpawnFromTop();
+    void Refill();
+
+    std::vector<Entry> _top;                    // Events at or after _topStart, unsorted
+    double _topStart;
+    std::vector<Rung> _rungs;                   // _rungs[0] spawned from top, later rungs are finer
+    std::vector<Entry> _bottom;                 // Earliest events, sorted
+    size_t _numEvents;
+    mutable double _backTime;                   // Latest pending timestamp, when cached
+    mutable bool _backTimeValid;
+};
@@ -1,5 +1,8 @@
 #include "OoO_EventSet.h"
+#include "OoO_EventQueue.h"
+#include "OoO_SimOptions.h"
 #include "OoO_SimModel.h"
+#include "OoO_ThreadPool.h"
 
 #include <iostream>
 #include <fstream>
@@ -11,6 +14,9 @@
 #include <random>
 #include <algorithm>
 #include <memory>
+#include <condition_variable>
+#include <functional>
+#include <cstdint>
 
 // Initialize the static member
 std::atomic<size_t> Entity::_entityCount{0};
@@ -21,43 +27,136 @@ Entity::Entity(double genTime)
 
 void Entity::setExitTime(double exitTime) { _exitTime = exitTime; }
 
-OoO_Event::OoO_Event(std::shared_ptr<Vertex> vertex, double time, std::shared_ptr<Entity> entity)
-: _vertex(vertex), _time(time), _entity(entity), _status(0)
+OoO_Event::OoO_Event()
+: _vertex(nullptr), _vertexIndex(0), _time(0), _status(0),
+  _sequenceNum(0), _queuePos(0)
 {}
 
 // Implementation of the copy constructor
 OoO_Event::OoO_Event(const OoO_Event& other)
 : _vertex(other._vertex),
+  _vertexIndex(other._vertexIndex),
   _time(other._time),
   _entity(other._entity),
   _status(other._status.load()),
+  _sequenceNum(other._sequenceNum),
+  _queuePos(other._queuePos),
   _newEvents(other._newEvents)
 {}
 
+void OoO_Event::Reset(Vertex* vertex, double time, std::shared_ptr<Entity> entity)
+{
+    _vertex = vertex;
+    _vertexIndex = vertex->getVertexIndex();
+    _time = time;
+    _entity = std::move(entity);
+    _status.store(0);
+}
+
+void OoO_Event::Release()
+{
+    _entity.reset();
+    _newEvents.Clear();
+}
+
 void OoO_Event::Execute()
 {
     _vertex->Run(_newEvents, _time, _entity);
 }
 
-int OoO_Event::getVertexIndex() const { return _vertex->getVertexIndex(); }
+OoO_Event* OoO_EventPool::Acquire(Vertex* vertex, double time, std::shared_ptr<Entity> entity)
+{
+    if (_free.empty()) {
+        _blocks.push_back(std::make_unique<OoO_Event[]>(_blockSize));
+        OoO_Event* block = _blocks.back().get();
+        for (size_t i = _blockSize; i-- > 0; ) {
+            _free.push_back(&block[i]);
+        }
+    }
+    OoO_Event* event = _free.back();
+    _free.pop_back();
+    event->Reset(vertex, time, std::move(entity));
+    return event;
+}
+
+void OoO_EventPool::Release(OoO_Event* event)
+{
+    event->Release();
+    _free.push_back(event);
+}
 
-OoO_EventSet::OoO_EventSet(std::vector<std::vector<float>> ITL, double maxSimTime)
-: _ITL(ITL), _maxSimTime(maxSimTime), _omega(32)
+OoO_EventSet::OoO_EventSet(OoO_ITLProvider ITL, double maxSimTime, const OoO_SimOptions& options)
+: _E(MakeEventQueue(options.eventSetBackend)), _ITL(std::move(ITL)), _window(_ITL), _hasPublishedITL(false),
+  _maxSimTime(maxSimTime), _omega(32), _trackReadyState(false), _numEventsInserted(0),
+  _E_RangeMax(0)
 {
     _maxTS_ByEventType = std::vector<double>(3, 0);
 }
 
-void OoO_EventSet::AddEvent(OoO_Event* newEvent)
+OoO_EventSet::~OoO_EventSet() = default;
+
+bool OoO_EventSet::GetEmpty() const { return _E->Empty(); }
+
+int OoO_EventSet::GetSize() const { return _E->Size(); }
+
+void OoO_EventSet::AddEvents(OoO_EventSink& newEvents)
+{
+    ScheduleNewEvents(newEvents, nullptr);
+}
+
+void OoO_EventSet::PublishITL(OoO_ITLProvider ITL)
+{
+    std::lock_guard<std::mutex> lock(_publishedITL_Mutex);
+    _publishedITL = std::make_unique<OoO_ITLProvider>(std::move(ITL));
+    _hasPublishedITL.store(true, std::memory_order_release);
+}
+
+void OoO_EventSet::InstallPublishedITL()
+{
+    {
+        std::lock_guard<std::mutex> lock(_publishedITL_Mutex);
+        _ITL = std::move(*_publishedITL);
+        _publishedITL.reset();
+        _hasPublishedITL.store(false, std::memory_order_relaxed);
+    }
+    
+    // Blockers found with the old limits no longer hold
+    _window.ReloadITL();
+    if (_trackReadyState) {
+        _window.Init(_E->Ordered());
+    }
+}
+
+void OoO_EventSet::InsertEvent(OoO_Event* newEvent)
 {
-    std::shared_ptr<OoO_Event> sharedPtr(newEvent);
-    _E.insert(std::move(sharedPtr));
+    // Backends order equal timestamp/vertex keys by the sequence number (insertion order)
+    newEvent->setSequenceNum(_numEventsInserted++);
+    _E->Insert(newEvent);
 }
 
-void OoO_EventSet::GetReadyEvents(std::list<std::shared_ptr<OoO_Event>>& readyEvents)
+void OoO_EventSet::ScheduleNewEvents(OoO_EventSink& newEvents, std::vector<OoO_Event*>* addedEvents)
 {
+    for (OoO_EventSink::Request& request : newEvents.getRequests()) {
+        OoO_Event* new_event = _pool.Acquire(request._vertex, request._time, std::move(request._entity));
+        if (nullptr != addedEvents) addedEvents->push_back(new_event);
+        InsertEvent(new_event);
+    }
+    newEvents.Clear();
+}
+
+void OoO_EventSet::InitReadyState()
+{
+    // Find an earlier event blocking each pending event
+    _window.Init(_E->Ordered());
+    _trackReadyState = true;
+}
+
+void OoO_EventSet::GetReadyEvents(std::list<OoO_Event*>& readyEvents)
+{
+    const std::vector<OoO_Event*>& events = _E->Ordered();
     int i = 0;
     // Iterate through event set, from start to end
-    for (auto later_it = _E.begin(); later_it != _E.end(); later_it++) {
+    for (auto later_it = events.begin(); later_it != events.end(); later_it++) {
         // Stop at omega if event set is too large
         if (i++ == _omega) break;
         
@@ -74,13 +173,13 @@ void OoO_EventSet::GetReadyEvents(std::list<std::shared_ptr<OoO_Event>>& readyEv
         _leVertInd = _eLater->getVertexIndex();
         
         // Iterate through event set, from beginning to before later event
-        for (auto earlier_it = _E.begin(); earlier_it != later_it; earlier_it++) {
+        for (auto earlier_it = events.begin(); earlier_it != later_it; earlier_it++) {
             // Get earlier event object
             _eEarlier = (*earlier_it);
             _eeVertInd = _eEarlier->getVertexIndex();
             
             // Get ITL-table limit of event pair
-            _eeLeLimit = static_cast<double>(_ITL[_eeVertInd][_leVertInd]);
+            _eeLeLimit = static_cast<double>(_ITL(_eeVertInd, _leVertInd));
             
             // If event pair is not independent, later event is not independent in event set
             if (_eLater->getTime() - _eEarlier->getTime() >= _eeLeLimit) {
@@ -107,46 +206,46 @@ void OoO_EventSet::GetReadyEvents(std::list<std::shared_ptr<OoO_Event>>& readyEv
     return;  
 }
 
-bool OoO_EventSet::UpdateEventSet(double& simTime)
+bool OoO_EventSet::UpdateEventSet(double& simTime, std::vector<OoO_Event*>& executedEvents)
 {
-    // Iterate through the event set
-    for (auto it = _E.begin(); it != _E.end(); ) {
-        // Event executed, ready for removal (atomic)
-        if (2 == (*it)->getStatus()) {
-            // Get new events from executed event
-            _newEvents = (*it)->getNewEvents();
-            
-            // Schedule new events in event set
-            for (auto& eventPtr : _newEvents) {
-                std::shared_ptr<OoO_Event> sharedPtr(eventPtr);
-                _E.insert(std::move(sharedPtr));
-            }
-            
-            // Empty new events container
-            _newEvents.clear();
-            
-            // Update simulation-clock time
-            if ((*it)->getTime() > simTime) {
-                simTime = (*it)->getTime();
-            }
-            
-            // Remove executed event
-            it = _E.erase(it);
-        }
-        // If not removing event, increment iterator
-        else {
-            ++it;
+    // Events added in this update, for the incremental ready-event state
+    std::vector<OoO_Event*> added_events;
+
+    // Handle executed events in event-set order, so new events are numbered as before
+    std::sort(executedEvents.begin(), executedEvents.end(), Precedes);
+
+    for (OoO_Event* executed_event : executedEvents) {
+        // Schedule new events from executed event in event set
+        ScheduleNewEvents(executed_event->getNewEvents(), _trackReadyState ? &added_events : nullptr);
+        
+        // Update simulation-clock time
+        if (executed_event->getTime() > simTime) {
+            simTime = executed_event->getTime();
         }
+        
+        // Remove executed event
+        _E->Erase(executed_event);
+    }
+
+    // Re-evaluate readiness against the removed and added events only
+    if (_trackReadyState) {
+        _window.Update(executedEvents, added_events);
+    }
+
+    // Executed events are no longer referenced, recycle them
+    for (OoO_Event* executed_event : executedEvents) {
+        _pool.Release(executed_event);
     }
 
     // Update statistics
-    if (!_E.empty()) {
-        _E_Sizes.push_back(_E.size());
-        _E_Ranges.push_back((*_E.rbegin())->getTime() - (*_E.begin())->getTime());
+    if (!_E->Empty()) {
+        _E_Sizes.push_back(_E->Size());
+        _E_Ranges.push_back(_E->BackTime() - _E->Front()->getTime());
+        _E_RangeMax = std::max(_E_RangeMax, _E->BackTime() - _E->Front()->getTime());
     }
 
     // Simulation will terminate if event set is empty or max time reached
-    return !_E.empty() && simTime <= _maxSimTime;
+    return !_E->Empty() && simTime <= _maxSimTime;
 }
 
 void OoO_EventSet::ExecuteSerial_IO(double& simTime, std::atomic<int>& numEventsExecuted, std::string IO_ExecOrderFilename)
@@ -159,21 +258,19 @@ void OoO_EventSet::ExecuteSerial_IO(double& simTime, std::atomic<int>& numEvents
     }
 	
     // Continue until event set is empty or max time is reached
-    while (!_E.empty() && (*_E.begin())->getTime() <= _maxSimTime) {
+    while (!_E->Empty() && _E->Front()->getTime() <= _maxSimTime) {
         // Update statistics
-        _E_Sizes.push_back(_E.size());
+        _E_Sizes.push_back(_E->Size());
         
-        // Get the first event (earliest timestamp)
-        std::shared_ptr<OoO_Event> first_event = *_E.begin();
+        // Take the first event (earliest timestamp) out of the event set
+        OoO_Event* first_event = _E->Front();
+        _E->Erase(first_event);
         
         // Execute the event
         first_event->Execute();
         
         // Add new events to the event set
-        for (auto& eventPtr : first_event->getNewEvents()) {
-            std::shared_ptr<OoO_Event> sharedPtr(eventPtr);
-            _E.insert(std::move(sharedPtr));
-        }
+        ScheduleNewEvents(first_event->getNewEvents(), nullptr);
         
         // Update simulation time and event counter
         simTime = first_event->getTime();
@@ -186,13 +283,14 @@ void OoO_EventSet::ExecuteSerial_IO(double& simTime, std::atomic<int>& numEvents
 			<< first_event->getVertex()->getVertexName() << std::endl;
         }
         
-        // Remove the executed event
-        _E.erase(_E.begin());
+        // Recycle the executed event
+        _pool.Release(first_event);
         
         // Update statistics
-        if (!_E.empty()) {
-            _E_Sizes.push_back(_E.size());
-            _E_Ranges.push_back((*_E.rbegin())->getTime() - (*_E.begin())->getTime());
+        if (!_E->Empty()) {
+            _E_Sizes.push_back(_E->Size());
+            _E_Ranges.push_back(_E->BackTime() - _E->Front()->getTime());
+            _E_RangeMax = std::max(_E_RangeMax, _E->BackTime() - _E->Front()->getTime());
         }
     }
     
@@ -201,7 +299,34 @@ void OoO_EventSet::ExecuteSerial_IO(double& simTime, std::atomic<int>& numEvents
 
 void OoO_EventSet::ExecuteSerial_OoO(double& simTime, std::atomic<int>& numEventsExecuted, int distSeed, int numSerialOoO_Execs, std::string IO_ExecOrderFilename)
 {
-    std::list<std::shared_ptr<OoO_Event>> ready_events;
+    Execute_OoO(simTime, numEventsExecuted, distSeed, numSerialOoO_Execs, IO_ExecOrderFilename, nullptr);
+}
+
+void OoO_EventSet::ExecuteParallel_OoO(double& simTime, std::atomic<int>& numEventsExecuted, int distSeed, int numSerialOoO_Execs, std::string IO_ExecOrderFilename, OoO_ThreadPool& threadPool)
+{
+    Execute_OoO(simTime, numEventsExecuted, distSeed, numSerialOoO_Execs, IO_ExecOrderFilename, &threadPool);
+}
+
+void OoO_EventSet::ExecuteEvents(std::vector<OoO_Event*>& events, OoO_ThreadPool* threadPool)
+{
+    // Ready events are independent of each other, so they may run concurrently
+    if (nullptr != threadPool) {
+        threadPool->ParallelFor(events.size(), [&events](size_t i) {
+            events[i]->Execute();
+            events[i]->setStatus(2);
+        });
+    } else {
+        for (OoO_Event* event : events) {
+            event->Execute();
+            event->setStatus(2);
+        }
+    }
+}
+
+void OoO_EventSet::Execute_OoO(double& simTime, std::atomic<int>& numEventsExecuted, int distSeed, int numSerialOoO_Execs, std::string IO_ExecOrderFilename, OoO_ThreadPool* threadPool)
+{
+    std::list<OoO_Event*> ready_events;
+    std::vector<OoO_Event*> exec_events;
     unsigned short num_ready_events;
     double mean_ready_event_index;
     double std_ready_event_index;
@@ -238,10 +363,19 @@ void OoO_EventSet::ExecuteSerial_OoO(double& simTime, std::atomic<int>& numEvent
     // Initialize random number generator
     std::mt19937 rng(distSeed);
 
+    // Blockers are kept up to date by UpdateEventSet from here on
+    InitReadyState();
+
     // Continue until event set is empty or max time is reached
-    while (!_E.empty() && (*_E.begin())->getTime() <= _maxSimTime) {
+    while (!_E->Empty() && _E->Front()->getTime() <= _maxSimTime) {
+        // No events are running here, so a newly published table can be switched in
+        if (_hasPublishedITL.load(std::memory_order_acquire)) {
+            InstallPublishedITL();
+        }
+        
         // Clear ready events and get new ones
         ready_events.clear();
+        exec_events.clear();
         std::string ready_event_names;
         GetReadyEventsOoO_Serial(ready_events, num_ready_events, mean_ready_event_index, 
                               std_ready_event_index, ready_event_names);
@@ -252,36 +386,36 @@ void OoO_EventSet::ExecuteSerial_OoO(double& simTime, std::atomic<int>& numEvent
         _readyEventIndexMeans.push_back(mean_ready_event_index);
         _readyEventIndexStds.push_back(std_ready_event_index);
         _readyEventNames.push_back(ready_event_names);
-        _E_Sizes.push_back(_E.size());
+        _E_Sizes.push_back(_E->Size());
 
         // Handle different OoO execution modes
         if (numSerialOoO_Execs > 0) {
             // Execute a power-of-2 number of events
-            int num_events_exec = 0;
-            for (std::shared_ptr<OoO_Event>& event : ready_events) {
-                event->Execute();
-                event->setStatus(2);
-                size_t event_count = numEventsExecuted.fetch_add(1);
-
-                if (++num_events_exec == std::pow(2, numSerialOoO_Execs)) break;
+            for (OoO_Event* event : ready_events) {
+                exec_events.push_back(event);
+                if (exec_events.size() == std::pow(2, numSerialOoO_Execs)) break;
             }
+            ExecuteEvents(exec_events, threadPool);
+            numEventsExecuted.fetch_add(exec_events.size());
         } else {
             // Execute a percentage of random events
             double percentage = -numSerialOoO_Execs * 10.0;
             int num_random_events = ceil((num_ready_events * percentage) / 100.0);
 
             // Convert list to vector for random selection
-            std::vector<std::shared_ptr<OoO_Event>> ready_events_vector(ready_events.begin(), ready_events.end());
+            std::vector<OoO_Event*> ready_events_vector(ready_events.begin(), ready_events.end());
             std::shuffle(ready_events_vector.begin(), ready_events_vector.end(), rng);
 
             // Execute the selected events
             for (int i = 0; i < num_random_events && i < ready_events_vector.size(); ++i) {
-                ready_events_vector[i]->Execute();
-                ready_events_vector[i]->setStatus(2);
+                exec_events.push_back(ready_events_vector[i]);
+            }
+            ExecuteEvents(exec_events, threadPool);
 
-                // Record execution for analysis
-                double timestamp = ready_events_vector[i]->getTime();
-                std::string vertex_name = ready_events_vector[i]->getVertex()->getVertexName();
+            // Record executions for analysis, in selection order
+            for (OoO_Event* event : exec_events) {
+                double timestamp = event->getTime();
+                std::string vertex_name = event->getVertex()->getVertexName();
                 //RE_sets << "(" << vertex_name << "," << timestamp << ")" << ",";
 				
 				// Serial OoO execution order
@@ -297,8 +431,8 @@ void OoO_EventSet::ExecuteSerial_OoO(double& simTime, std::atomic<int>& numEvent
             //RE_sets << std::endl;
         }
         
-        // Update the event set
-        UpdateEventSet(simTime);
+        // Update the event set with the events just executed
+        UpdateEventSet(simTime, exec_events);
     }
 	
 	// Serial OoO execution order
@@ -320,7 +454,116 @@ void OoO_EventSet::ExecuteSerial_OoO(double& simTime, std::atomic<int>& numEvent
     return;
 }
 
-void OoO_EventSet::GetReadyEventsOoO_Serial(std::list<std::shared_ptr<OoO_Event>>& readyEvents, 
+void OoO_EventSet::ExecutePipelined_OoO(double& simTime, std::atomic<int>& numEventsExecuted, int distSeed, int numSerialOoO_Execs, OoO_ThreadPool& threadPool)
+{
+    // Events the workers have run and this thread has not committed yet
+    std::mutex executed_mutex;
+    std::condition_variable executed_CV;
+    std::vector<OoO_Event*> executed_events;
+    std::vector<OoO_Event*> commit_events;
+    std::vector<OoO_Event*> candidate_events;
+    size_t num_in_flight = 0;
+
+    // Power-of-2 mode bounds the events running at once; percentage mode starts a random share of
+    // the ready events each pass
+    const size_t max_in_flight = (numSerialOoO_Execs > 0) ? static_cast<size_t>(std::pow(2, numSerialOoO_Execs)) : SIZE_MAX;
+    const double percentage = -numSerialOoO_Execs * 10.0;
+
+    // Initialize random number generator
+    std::mt19937 rng(distSeed);
+
+    // Blockers are kept up to date by UpdateEventSet from here on
+    InitReadyState();
+
+    // Tokens are the events themselves
+    const std::function<void(size_t)> execute_event = [&](size_t token) {
+        OoO_Event* event = reinterpret_cast<OoO_Event*>(token);
+        event->Execute();
+        event->setStatus(2);
+        {
+            std::lock_guard<std::mutex> lock(executed_mutex);
+            executed_events.push_back(event);
+        }
+        executed_CV.notify_one();
+    };
+    threadPool.BeginStream(execute_event);
+
+    bool discover = true;
+    while (true) {
+        // Commit the events that finished since the last pass
+        {
+            std::lock_guard<std::mutex> lock(executed_mutex);
+            commit_events.swap(executed_events);
+        }
+        if (!commit_events.empty()) {
+            num_in_flight -= commit_events.size();
+            numEventsExecuted.fetch_add(commit_events.size());
+            UpdateEventSet(simTime, commit_events);
+            commit_events.clear();
+            discover = true;
+        }
+
+        // A published table is switched in once no event is running; none are started until then
+        bool install_ITL = _hasPublishedITL.load(std::memory_order_acquire);
+        if (install_ITL && 0 == num_in_flight) {
+            InstallPublishedITL();
+            install_ITL = false;
+            discover = true;
+        }
+
+        bool pending = !_E->Empty() && _E->Front()->getTime() <= _maxSimTime;
+        if (!pending && 0 == num_in_flight) break;
+
+        // Readiness only changes when events are committed or the limits change, and an event that is
+        // ready stays ready while earlier events run, so each pass can start events right away
+        if (pending && discover && !install_ITL && num_in_flight < max_in_flight) {
+            discover = false;
+            unsigned short num_ready_events = 0;
+            candidate_events.clear();
+            for (size_t window_index = 0; window_index < _window.Size(); window_index++) {
+                if (!_window.IsReady(window_index)) continue;
+                num_ready_events++;
+                OoO_Event* event = _window.getEvent(window_index);
+                if (0 == event->getStatus()) candidate_events.push_back(event);
+            }
+
+            // Update statistics
+            _readyEventsSizes.push_back(num_ready_events);
+            _E_Sizes.push_back(_E->Size());
+
+            size_t num_selected;
+            if (numSerialOoO_Execs > 0) {
+                // Earliest ready events first
+                num_selected = std::min(candidate_events.size(), max_in_flight - num_in_flight);
+            } else {
+                std::shuffle(candidate_events.begin(), candidate_events.end(), rng);
+                num_selected = std::min<size_t>(candidate_events.size(), ceil((candidate_events.size() * percentage) / 100.0));
+            }
+            for (size_t i = 0; i < num_selected; i++) {
+                candidate_events[i]->setStatus(1);
+                num_in_flight++;
+                threadPool.Submit(reinterpret_cast<size_t>(candidate_events[i]));
+            }
+            continue;
+        }
+
+        // Nothing new to find until an event finishes: help run the queued events, committing them
+        // together afterwards, or wait for a worker to finish one
+        bool ran_events = false;
+        while (threadPool.RunSubmitted()) {
+            ran_events = true;
+        }
+        if (!ran_events) {
+            std::unique_lock<std::mutex> lock(executed_mutex);
+            executed_CV.wait(lock, [&executed_events] { return !executed_events.empty(); });
+        }
+    }
+
+    threadPool.EndStream();
+    return;
+}
+
+void OoO_EventSet::GetReadyEventsOoO_Serial(std::list<OoO_Event*>& readyEvents, 
                                          unsigned short& numReadyEvents, double& meanReadyEventIndex, 
                                          double& stdReadyEventIndex, std::string& readyEventNames)
 {
@@ -331,38 +574,22 @@ void OoO_EventSet::GetReadyEventsOoO_Serial(std::list<std::shared_ptr<OoO_Event>
     std::list<int> ready_event_indices;
     int i = 0;
     
-    // Iterate through event set
-    for (auto later_it = _E.begin(); later_it != _E.end(); later_it++) {
-        // Get later event
-        _eLater = (*later_it);
-        _leIndep = true;
-        _leVertInd = _eLater->getVertexIndex();
+    // Iterate through event set, mirrored in the window
+    for (size_t window_index = 0; window_index < _window.Size(); window_index++) {
+        OoO_Event* later_event = _window.getEvent(window_index);
 
         // Record event info
-        //double timestamp = _eLater->getTime();
-        //std::string vertex_name = _eLater->getVertex()->getVertexName();
+        //double timestamp = later_event->getTime();
+        //std::string vertex_name = later_event->getVertex()->getVertexName();
         //E_sets << "(" << vertex_name << "," << timestamp << ")" << ",";
 
-        // Check event independence against all earlier events
-        for (auto earlier_it = _E.begin(); earlier_it != later_it; earlier_it++) {
-            _eEarlier = (*earlier_it);
-            _eeVertInd = _eEarlier->getVertexIndex();
-            _eeLeLimit = static_cast<double>(_ITL[_eeVertInd][_leVertInd]);
-            
-            // Check if event is dependent
-            if (_eLater->getTime() - _eEarlier->getTime() >= _eeLeLimit) {
-                _leIndep = false;
-                break;
-            }
-        }
-        
-        // Process independent events
-        if (_leIndep) {
+        // Event is independent when no earlier event blocks it
+        if (_window.IsReady(window_index)) {
             // Mark as ready
-            _eLater->setStatus(1);
+            later_event->setStatus(1);
             
             // Add to ready events
-            readyEvents.push_back(_eLater);
+            readyEvents.push_back(later_event);
             numReadyEvents++;
             ready_event_indices.push_back(i);
         }
@@ -398,7 +625,8 @@ void OoO_EventSet::CountReadyEventsIO_Serial(unsigned short& numReadyEvents, dou
     int i = 0;
     
     // Iterate through event set to find independent events
-    for (auto later_it = _E.begin(); later_it != _E.end(); later_it++) {
+    const std::vector<OoO_Event*>& events = _E->Ordered();
+    for (auto later_it = events.begin(); later_it != events.end(); later_it++) {
         _eLater = (*later_it);
         _leIndep = true;
         _leVertInd = _eLater->getVertexIndex();
@@ -409,10 +637,10 @@ void OoO_EventSet::CountReadyEventsIO_Serial(unsigned short& numReadyEvents, dou
         }
 
         // Check independence against all earlier events
-        for (auto earlier_it = _E.begin(); earlier_it != later_it; earlier_it++) {
+        for (auto earlier_it = events.begin(); earlier_it != later_it; earlier_it++) {
             _eEarlier = (*earlier_it);
             _eeVertInd = _eEarlier->getVertexIndex();
-            _eeLeLimit = static_cast<double>(_ITL[_eeVertInd][_leVertInd]);
+            _eeLeLimit = static_cast<double>(_ITL(_eeVertInd, _leVertInd));
             
             if (_eLater->getTime() - _eEarlier->getTime() >= _eeLeLimit) {
                 _leIndep = false;
@@ -451,7 +679,7 @@ void OoO_EventSet::CountReadyEventsIO_Serial(unsigned short& numReadyEvents, dou
 void OoO_EventSet::PrintE()
 {
     int i = 1;
-    for (auto E_event : _E) {
+    for (OoO_Event* E_event : _E->Ordered()) {
         int vertex_index = E_event->getVertexIndex();
         std::string vertex_name = E_event->getVertex()->getVertexName();
         double event_time = E_event->getTime();
@@ -479,6 +707,11 @@ double OoO_EventSet::GetE_RangesMeanRange()
            std::accumulate(_E_Ranges.begin(), _E_Ranges.end(), 0.0) / _E_Ranges.size();
 }
 
+double OoO_EventSet::GetE_RangesMaxRange()
+{
+    return _E_RangeMax;
+}
+
 void OoO_EventSet::WriteSerialReadyEventsToCSV()
 {
     // Open the output file stream
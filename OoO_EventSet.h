@@ -5,8 +5,15 @@
 #include <set>
 #include <memory>
 #include <atomic>
+#include <mutex>
+
+#include "OoO_ITLProvider.h"
+#include "OoO_EventWindow.h"
 
 class Vertex;
+class OoO_ThreadPool;
+class OoO_EventQueue;
+struct OoO_SimOptions;
 
 struct EventRecord {
     size_t _sequenceNum;
@@ -28,34 +35,83 @@ private:
     static std::atomic<size_t> _entityCount; // Counter for generating unique IDs
 };
 
+// Collects the events a vertex schedules while it runs; the event set creates them afterwards.
+// Cleared sinks keep their capacity, so scheduling stops allocating once warmed up.
+class OoO_EventSink {
+public:
+    struct Request {
+        Vertex* _vertex;
+        double _time;
+        std::shared_ptr<Entity> _entity;
+    };
+
+    void Schedule(Vertex* vertex, double time, std::shared_ptr<Entity> entity) {
+        _requests.push_back(Request{vertex, time, std::move(entity)});
+    }
+    std::vector<Request>& getRequests() { return _requests; }
+    void Clear() { _requests.clear(); }
+
+private:
+    std::vector<Request> _requests;
+};
+
 class OoO_Event {
 public:
-    OoO_Event(std::shared_ptr<Vertex> vertex, double time, std::shared_ptr<Entity> entity);
+    OoO_Event();
     OoO_Event(const OoO_Event& other);
     
+    // Reinitialize a pooled event
+    void Reset(Vertex* vertex, double time, std::shared_ptr<Entity> entity);
+    
+    // Drop the entity and scheduled events before the event returns to the pool
+    void Release();
+    
     // Execute this event
     void Execute();
     
     // Getters and setters
-    std::list<OoO_Event*>& getNewEvents() { return _newEvents; }
+    OoO_EventSink& getNewEvents() { return _newEvents; }
     double getTime() const { return _time; }
-    std::shared_ptr<Vertex> getVertex() { return _vertex; }
-    int getVertexIndex() const;
+    Vertex* getVertex() const { return _vertex; }
+    int getVertexIndex() const { return _vertexIndex; }
     void setStatus(int status) { _status.store(status); }
     int getStatus() const { return _status.load(); }
+    void setSequenceNum(size_t sequenceNum) { _sequenceNum = sequenceNum; }
+    size_t getSequenceNum() const { return _sequenceNum; }
+    void setQueuePos(size_t queuePos) { _queuePos = queuePos; }
+    size_t getQueuePos() const { return _queuePos; }
     
 private:
-    std::shared_ptr<Vertex> _vertex;   // Vertex associated with this event
-    const double _time;                // Time at which this event occurs
+    Vertex* _vertex;                   // Vertex associated with this event (owned by the model)
+    int _vertexIndex;                  // Index of the associated vertex, cached for ready-event checks
+    double _time;                      // Time at which this event occurs
     std::shared_ptr<Entity> _entity;   // Entity associated with this event
     std::atomic<int> _status;          // Status of the event (0=idle, 1=ready, 2=executed)
-    std::list<OoO_Event*> _newEvents;  // New events generated during execution
+    size_t _sequenceNum;               // Order of insertion into the event set, breaks timestamp/vertex ties
+    size_t _queuePos;                  // Position inside the event-set backend, where it keeps one
+    OoO_EventSink _newEvents;          // New events generated during execution
+};
+
+// Recycles events in fixed-size blocks, so events are not allocated one at a time
+class OoO_EventPool {
+public:
+    OoO_EventPool() = default;
+    OoO_EventPool(const OoO_EventPool&) = delete;
+    OoO_EventPool& operator=(const OoO_EventPool&) = delete;
+
+    OoO_Event* Acquire(Vertex* vertex, double time, std::shared_ptr<Entity> entity);
+    void Release(OoO_Event* event);
+
+private:
+    static constexpr size_t _blockSize = 1024;          // Events per allocated block
+    std::vector<std::unique_ptr<OoO_Event[]>> _blocks;  // Storage for all events
+    std::vector<OoO_Event*> _free;                      // Events available for reuse
 };
 
 // Comparison functor for ordering events in the event set
 struct EventPtr_Compare final
 {
-    bool operator() (const std::shared_ptr<OoO_Event> left, const std::shared_ptr<OoO_Event> right) const
+    bool operator() (const OoO_Event* left, const OoO_Event* right) const
     {
         if (left->getTime() < right->getTime()) return true;
         if (right->getTime() < left->getTime()) return false;
@@ -66,20 +122,25 @@ struct EventPtr_Compare final
 
 class OoO_EventSet {
 public:
-    OoO_EventSet(std::vector<std::vector<float>> ITL, double maxSimTime);
+    OoO_EventSet(OoO_ITLProvider ITL, double maxSimTime, const OoO_SimOptions& options);
+    ~OoO_EventSet();
     
     // Get all ready events from the event set
-    void GetReadyEvents(std::list<std::shared_ptr<OoO_Event>>& readyEvents);
+    void GetReadyEvents(std::list<OoO_Event*>& readyEvents);
+    
+    // Update the event set after executing events, given the events that were executed
+    bool UpdateEventSet(double& simTime, std::vector<OoO_Event*>& executedEvents);
     
-    // Update the event set after executing events
-    bool UpdateEventSet(double& simTime);
+    // Create and add the events scheduled in a sink, then clear it
+    void AddEvents(OoO_EventSink& newEvents);
     
-    // Add a new event to the event set
-    void AddEvent(OoO_Event* newEvent);
+    // Replace the ITL limits; safe to call from any thread, and out-of-order execution switches to the
+    // new limits between two batches of events, so no readiness check mixes the old and new tables
+    void PublishITL(OoO_ITLProvider ITL);
     
     // Query methods for the event set
-    bool GetEmpty() const { return _E.empty(); }
-    int GetSize() const { return _E.size(); }
+    bool GetEmpty() const;
+    int GetSize() const;
     
     // Execute events serially in timestamp order
     void ExecuteSerial_IO(double& simTime, std::atomic<int>& numEventsExecuted, std::string IO_ExecOrderFilename);
@@ -88,8 +149,18 @@ public:
     void ExecuteSerial_OoO(double& simTime, std::atomic<int>& numEventsExecuted, int distSeed,
                          int numSerialOoO_Execs, std::string IO_ExecOrderFilename);
     
+    // Execute out-of-order, running each selected batch of ready events on the thread pool
+    void ExecuteParallel_OoO(double& simTime, std::atomic<int>& numEventsExecuted, int distSeed,
+                           int numSerialOoO_Execs, std::string IO_ExecOrderFilename, OoO_ThreadPool& threadPool);
+    
+    // Execute out-of-order with discovery overlapped with execution: this thread keeps finding ready
+    // events in the current event set while the pool's workers run the ones already found, and each
+    // event is committed to the event set as soon as it has run
+    void ExecutePipelined_OoO(double& simTime, std::atomic<int>& numEventsExecuted, int distSeed,
+                              int numSerialOoO_Execs, OoO_ThreadPool& threadPool);
+    
     // Get ready events for out-of-order serial execution
-    void GetReadyEventsOoO_Serial(std::list<std::shared_ptr<OoO_Event>>& readyEvents, 
+    void GetReadyEventsOoO_Serial(std::list<OoO_Event*>& readyEvents, 
                                 unsigned short& numReadyEvents, double& meanReadyEventIndex, 
                                 double& stdReadyEventIndex, std::string& readyEventNames);
     
@@ -104,26 +175,61 @@ public:
     double GetReadyEventsMeanSize();
     double GetE_SizesMeanSize();
     double GetE_RangesMeanRange();
+    double GetE_RangesMaxRange();
     
     // Export statistics to CSV
     void WriteSerialReadyEventsToCSV();
     
 private:
-    std::multiset<std::shared_ptr<OoO_Event>, EventPtr_Compare> _E;     // Event set
-    std::vector<std::vector<float>> _ITL;            // Independence Time Limit table
-    std::list<OoO_Event*> _newEvents;                // New events generated during execution
-    std::shared_ptr<OoO_Event> _eLater;              // Later event in ITL check
-    std::shared_ptr<OoO_Event> _eEarlier;            // Earlier event in ITL check
+    // Shared out-of-order driver; events run serially when threadPool is null
+    void Execute_OoO(double& simTime, std::atomic<int>& numEventsExecuted, int distSeed,
+                   int numSerialOoO_Execs, std::string IO_ExecOrderFilename, OoO_ThreadPool* threadPool);
+    
+    // Incremental ready-event state: the window keeps, for each pending event, an earlier event
+    // that blocks it, rechecked only against the events an update inserts or removes
+    void InitReadyState();
+    
+    // Switch to the most recently published ITL limits and recheck every pending event against them
+    void InstallPublishedITL();
+    
+    // Insert an event, recording its insertion order
+    void InsertEvent(OoO_Event* newEvent);
+    
+    // Create the events scheduled in a sink, optionally collecting them, and clear the sink
+    void ScheduleNewEvents(OoO_EventSink& newEvents, std::vector<OoO_Event*>* addedEvents);
+    
+    // Event-set order: timestamp, then vertex index, then insertion order
+    static bool Precedes(const OoO_Event* first, const OoO_Event* second) {
+        if (first->getTime() != second->getTime()) return first->getTime() < second->getTime();
+        if (first->getVertexIndex() != second->getVertexIndex()) return first->getVertexIndex() < second->getVertexIndex();
+        return first->getSequenceNum() < second->getSequenceNum();
+    }
+    
+    // Execute a batch of ready events and mark them as executed
+    void ExecuteEvents(std::vector<OoO_Event*>& events, OoO_ThreadPool* threadPool);
+    
+    OoO_EventPool _pool;                             // Storage for pending events, declared before the event set
+    std::unique_ptr<OoO_EventQueue> _E;              // Event set, on the configured backend
+    OoO_ITLProvider _ITL;                            // Independence Time Limit table
+    OoO_EventWindow _window;                         // Pending events with their blockers, in event-set order
+    std::mutex _publishedITL_Mutex;                  // Guards _publishedITL
+    std::unique_ptr<OoO_ITLProvider> _publishedITL;  // Limits waiting to be installed
+    std::atomic<bool> _hasPublishedITL;              // Set while _publishedITL holds limits
+    OoO_Event* _eLater;                              // Later event in ITL check
+    OoO_Event* _eEarlier;                            // Earlier event in ITL check
     int _eeVertInd, _leVertInd;                      // Vertex indices for ITL check
     bool _leIndep;                                   // Flag for event independence
     double _eeLeLimit;                               // ITL limit
     const int _omega;                                // Maximum events to check in GetReadyEvents
     const double _maxSimTime;                        // Maximum simulation time
+    bool _trackReadyState;                           // Blockers are maintained incrementally
+    size_t _numEventsInserted;                       // Sequence number for the next inserted event
     
     // Statistics collection
     std::list<unsigned short> _readyEventsSizes;     // Sizes of ready event sets
     std::list<unsigned short> _E_Sizes;              // Sizes of event set
     std::list<unsigned short> _E_Ranges;             // Ranges of event timestamps
+    double _E_RangeMax;                              // Largest range of event timestamps
     
     // Serial execution statistics
     std::list<unsigned short> _numReadyEventsSerial; // Number of ready events in serial execution
@@ -0,0 +1,445 @@
+#include "OoO_EventWindow.h"
+#include "OoO_EventSet.h"
+
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define OOO_X86_KERNELS
+#endif
+
+// Scalar kernel
+
+static size_t FirstBlocker_Scalar(const double* times, const int* vertexIndices,
+                                  size_t begin, size_t end, double time, const float* ITLColumn)
+{
+    for (size_t i = begin; i < end; i++) {
+        if (time - times[i] >= static_cast<double>(ITLColumn[vertexIndices[i]])) return i;
+    }
+    return end;
+}
+
+// Scalar compact kernels
+
+static size_t FirstBlocker16_Scalar(const double* times, const int* vertexIndices,
+                                    size_t begin, size_t end, double time, const uint16_t* codeColumn, float scale)
+{
+    for (size_t i = begin; i < end; i++) {
+        uint16_t code = codeColumn[vertexIndices[i]];
+        if (OoO_CompactITL::_neverCode16 != code && time - times[i] >= static_cast<double>(code * scale)) return i;
+    }
+    return end;
+}
+
+static size_t FirstBlocker8_Scalar(const double* times, const int* vertexIndices,
+                                   size_t begin, size_t end, double time, const uint8_t* codeColumn,
+                                   const float* codeLimits)
+{
+    for (size_t i = begin; i < end; i++) {
+        if (time - times[i] >= static_cast<double>(codeLimits[codeColumn[vertexIndices[i]]])) return i;
+    }
+    return end;
+}
+
+#ifdef OOO_X86_KERNELS
+
+// SSE2 kernel: two events per step, limits loaded one at a time
+
+static size_t FirstBlocker_SSE2(const double* times, const int* vertexIndices,
+                                size_t begin, size_t end, double time, const float* ITLColumn)
+{
+    const __m128d time_v = _mm_set1_pd(time);
+    size_t i = begin;
+    for (; i + 2 <= end; i += 2) {
+        __m128d limit = _mm_set_pd(ITLColumn[vertexIndices[i + 1]], ITLColumn[vertexIndices[i]]);
+        __m128d diff = _mm_sub_pd(time_v, _mm_loadu_pd(times + i));
+        int blocks = _mm_movemask_pd(_mm_cmpge_pd(diff, limit));
+        if (0 != blocks) return i + __builtin_ctz(blocks);
+    }
+    for (; i < end; i++) {
+        if (time - times[i] >= static_cast<double>(ITLColumn[vertexIndices[i]])) return i;
+    }
+    return end;
+}
+
+// AVX2 kernel: four events per step, limits gathered from the ITL column
+
+__attribute__((target("avx2")))
+static size_t FirstBlocker_AVX2(const double* times, const int* vertexIndices,
+                                size_t begin, size_t end, double time, const float* ITLColumn)
+{
+    const __m256d time_v = _mm256_set1_pd(time);
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128i vertex_indices = _mm_loadu_si128(reinterpret_cast<const __m128i*>(vertexIndices + i));
+        __m256d limit = _mm256_cvtps_pd(_mm_i32gather_ps(ITLColumn, vertex_indices, 4));
+        __m256d diff = _mm256_sub_pd(time_v, _mm256_loadu_pd(times + i));
+        int blocks = _mm256_movemask_pd(_mm256_cmp_pd(diff, limit, _CMP_GE_OQ));
+        if (0 != blocks) return i + __builtin_ctz(blocks);
+    }
+    for (; i < end; i++) {
+        if (time - times[i] >= static_cast<double>(ITLColumn[vertexIndices[i]])) return i;
+    }
+    return end;
+}
+
+// AVX2 compact kernels: codes gathered as 32-bit words at their byte offsets and masked, so the table
+// carries a few bytes of padding for the last code
+
+__attribute__((target("avx2")))
+static size_t FirstBlocker16_AVX2(const double* times, const int* vertexIndices,
+                                  size_t begin, size_t end, double time, const uint16_t* codeColumn, float scale)
+{
+    const __m256d time_v = _mm256_set1_pd(time);
+    const __m256d scale_v = _mm256_set1_pd(scale);
+    const __m128i code_mask = _mm_set1_epi32(0xFFFF);
+    const __m128i never_code = _mm_set1_epi32(OoO_CompactITL::_neverCode16);
+    const int* code_words = reinterpret_cast<const int*>(codeColumn);
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128i vertex_indices = _mm_loadu_si128(reinterpret_cast<const __m128i*>(vertexIndices + i));
+        __m128i codes = _mm_and_si128(_mm_i32gather_epi32(code_words, vertex_indices, 2), code_mask);
+        __m256d limit = _mm256_mul_pd(_mm256_cvtepi32_pd(codes), scale_v);
+        __m256d diff = _mm256_sub_pd(time_v, _mm256_loadu_pd(times + i));
+        int never = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(codes, never_code)));
+        int blocks = _mm256_movemask_pd(_mm256_cmp_pd(diff, limit, _CMP_GE_OQ)) & ~never;
+        if (0 != blocks) return i + __builtin_ctz(blocks);
+    }
+    return FirstBlocker16_Scalar(times, vertexIndices, i, end, time, codeColumn, scale);
+}
+
+__attribute__((target("avx2")))
+static size_t FirstBlocker8_AVX2(const double* times, const int* vertexIndices,
+                                 size_t begin, size_t end, double time, const uint8_t* codeColumn,
+                                 const float* codeLimits)
+{
+    const __m256d time_v = _mm256_set1_pd(time);
+    const __m128i code_mask = _mm_set1_epi32(0xFF);
+    const int* code_words = reinterpret_cast<const int*>(codeColumn);
+    size_t i = begin;
+    for (; i + 4 <= end; i += 4) {
+        __m128i vertex_indices = _mm_loadu_si128(reinterpret_cast<const __m128i*>(vertexIndices + i));
+        __m128i codes = _mm_and_si128(_mm_i32gather_epi32(code_words, vertex_indices, 1), code_mask);
+        __m256d limit = _mm256_cvtps_pd(_mm_i32gather_ps(codeLimits, codes, 4));
+        __m256d diff = _mm256_sub_pd(time_v, _mm256_loadu_pd(times + i));
+        int blocks = _mm256_movemask_pd(_mm256_cmp_pd(diff, limit, _CMP_GE_OQ));
+        if (0 != blocks) return i + __builtin_ctz(blocks);
+    }
+    return FirstBlocker8_Scalar(times, vertexIndices, i, end, time, codeColumn, codeLimits);
+}
+
+#endif
+
+// Transposed copy of a dense table, unless the provider already holds one
+static OoO_ITLMatrix TransposedCopyOf(const OoO_ITLProvider& ITL)
+{
+    return ITL.TransposedMatrix().empty() ? ITL.Matrix().Transposed() : OoO_ITLMatrix();
+}
+
+// Columns of finite limits, from whichever dense table the provider holds
+static OoO_DependentPairs DependentPairsOf(const OoO_ITLProvider& ITL)
+{
+    if (ITL.IsHorizon()) return ITL.HorizonLimits();
+    return ITL.IsCompact() ? OoO_DependentPairs(ITL.CompactTable()) : OoO_DependentPairs(ITL.Matrix());
+}
+
+OoO_EventWindow::OoO_EventWindow(const OoO_ITLProvider& ITL)
+: _ITL(ITL), _ITL_T(TransposedCopyOf(ITL)), _compactITL_T(ITL.CompactTable().Transposed()),
+  _dependents(DependentPairsOf(ITL)), _frontierPositionOf(ITL.size(), SIZE_MAX)
+{
+    // Pick the widest kernel this CPU supports; compact tables have no SSE2 kernels
+    _firstBlockerKernel = FirstBlocker_Scalar;
+    _firstBlockerKernel16 = FirstBlocker16_Scalar;
+    _firstBlockerKernel8 = FirstBlocker8_Scalar;
+    _kernelName = "scalar";
+#ifdef OOO_X86_KERNELS
+    if (__builtin_cpu_supports("avx2")) {
+        _firstBlockerKernel = FirstBlocker_AVX2;
+        _firstBlockerKernel16 = FirstBlocker16_AVX2;
+        _firstBlockerKernel8 = FirstBlocker8_AVX2;
+        _kernelName = "AVX2";
+    } else if (__builtin_cpu_supports("sse2")) {
+        _firstBlockerKernel = FirstBlocker_SSE2;
+        _kernelName = "SSE2";
+    }
+#endif
+    _ITLColumns = _ITL.TransposedMatrix().empty() ? &_ITL_T : &_ITL.TransposedMatrix();
+    BuildHorizonColumns();
+}
+
+void OoO_EventWindow::ReloadITL()
+{
+    _ITL_T = TransposedCopyOf(_ITL);
+    _ITLColumns = _ITL.TransposedMatrix().empty() ? &_ITL_T : &_ITL.TransposedMatrix();
+    _compactITL_T = _ITL.CompactTable().Transposed();
+    _dependents = DependentPairsOf(_ITL);
+    BuildHorizonColumns();
+    _frontierVertexIndices.clear();
+    _frontierPositionOf.assign(_ITL.size(), SIZE_MAX);
+}
+
+void OoO_EventWindow::BuildHorizonColumns()
+{
+    _horizonColumns.clear();
+    _horizonColumnOffsets.assign(_ITL.size(), SIZE_MAX);
+    if (!_ITL.IsHorizon()) return;
+
+    const size_t num_vertices = _ITL.size();
+    for (size_t k=0; k<num_vertices; k++) {
+        if (_dependents.ColumnSize(k) * 4 < num_vertices) continue;
+        _horizonColumnOffsets[k] = _horizonColumns.size();
+        _horizonColumns.resize(_horizonColumns.size() + num_vertices, _ITL.getHorizon());
+        float* column = &_horizonColumns[_horizonColumnOffsets[k]];
+        for (size_t entry = _dependents.ColumnBegin(k); entry < _dependents.ColumnEnd(k); entry++) {
+            column[_dependents.getVertexIndex(entry)] = _dependents.getLimit(entry);
+        }
+    }
+}
+
+size_t OoO_EventWindow::LowerBound(double time, int vertexIndex, size_t sequenceNum) const
+{
+    size_t first = 0;
+    size_t count = _times.size();
+    while (count > 0) {
+        size_t step = count / 2;
+        size_t i = first + step;
+        bool precedes = (_times[i] != time) ? (_times[i] < time) :
+                        (_vertexIndices[i] != vertexIndex) ? (_vertexIndices[i] < vertexIndex) :
+                        (_sequenceNums[i] < sequenceNum);
+        if (precedes) {
+            first = i + 1;
+            count -= step + 1;
+        } else {
+            count = step;
+        }
+    }
+    return first;
+}
+
+size_t OoO_EventWindow::FindBlocker(size_t begin, size_t i, size_t frontierEnd) const
+{
+    auto positions_begin = _frontierPositions.begin();
+    size_t first = (0 == begin) ? 0 : std::lower_bound(positions_begin, positions_begin + frontierEnd, begin) - positions_begin;
+    int vertex_index = _vertexIndices[i];
+
+    // Horizon limits: unlisted limits are the horizon, so the frontier event at begin, the earliest one
+    // in range, is the first blocker if it is that far back; otherwise only listed limits can block
+    if (_ITL.IsHorizon()) {
+        const float* column = HorizonColumn(vertex_index);
+        if (nullptr != column && _dependents.ColumnSize(vertex_index) >= frontierEnd) {
+            size_t blocker = _firstBlockerKernel(_frontierTimes.data(), _frontierVertexIndices.data(), first, frontierEnd,
+                                                 _times[i], column);
+            return (blocker == frontierEnd) ? _ready : _frontierPositions[blocker];
+        }
+        if (first < frontierEnd && _times[i] - _frontierTimes[first] >= static_cast<double>(_ITL.getHorizon())) {
+            return _frontierPositions[first];
+        }
+        return FindDependentBlocker(begin, i);
+    }
+
+    // Tiled limits: no column in memory, read each one through the tile cache
+    if (_ITL.IsTiled()) {
+        const OoO_TiledITL& tiled = _ITL.TiledTable();
+        for (size_t f=first; f<frontierEnd; f++) {
+            if (_times[i] - _frontierTimes[f] >= static_cast<double>(tiled(_frontierVertexIndices[f], vertex_index))) {
+                return _frontierPositions[f];
+            }
+        }
+        return _ready;
+    }
+
+    // Lattice limits: no dense column to gather from, so scan the frontier looking each limit up
+    if (_ITL.IsLattice()) {
+        for (size_t f=first; f<frontierEnd; f++) {
+            if (_times[i] - _frontierTimes[f] >= static_cast<double>(_ITL(_frontierVertexIndices[f], vertex_index))) {
+                return _frontierPositions[f];
+            }
+        }
+        return _ready;
+    }
+
+    // Sparse column: fewer vertices can affect this one than the frontier holds, so visit only their
+    // frontier events
+    if (_dependents.ColumnSize(vertex_index) < frontierEnd) {
+        return FindDependentBlocker(begin, i);
+    }
+
+    // Frontier events at positions [begin, i), by the SIMD kernels chosen at runtime: they gather from
+    // the float column, or decode the 16- or 8-bit code column of a compact table
+    size_t blocker;
+    if (!_ITL.IsCompact()) {
+        blocker = _firstBlockerKernel(_frontierTimes.data(), _frontierVertexIndices.data(), first, frontierEnd,
+                                      _times[i], ITLColumn(vertex_index));
+    } else if (OoO_CompactITL::Fixed16 == _compactITL_T.getEncoding()) {
+        blocker = _firstBlockerKernel16(_frontierTimes.data(), _frontierVertexIndices.data(), first, frontierEnd,
+                                        _times[i], _compactITL_T.Codes16(vertex_index), _compactITL_T.getScale());
+    } else {
+        blocker = _firstBlockerKernel8(_frontierTimes.data(), _frontierVertexIndices.data(), first, frontierEnd,
+                                       _times[i], _compactITL_T.Codes8(vertex_index), _compactITL_T.getQuantumLimits());
+    }
+    return (blocker == frontierEnd) ? _ready : _frontierPositions[blocker];
+}
+
+size_t OoO_EventWindow::FindDependentBlocker(size_t begin, size_t i) const
+{
+    int vertex_index = _vertexIndices[i];
+    size_t blocker = _ready;
+    for (size_t entry = _dependents.ColumnBegin(vertex_index); entry < _dependents.ColumnEnd(vertex_index); entry++) {
+        size_t pos = _frontierPositionOf[_dependents.getVertexIndex(entry)];
+        if (pos >= begin && pos < i && pos < blocker &&
+            _times[i] - _times[pos] >= static_cast<double>(_dependents.getLimit(entry))) {
+            blocker = pos;
+        }
+    }
+    return blocker;
+}
+
+void OoO_EventWindow::BuildFrontier()
+{
+    for (int vertex_index : _frontierVertexIndices) {
+        _frontierPositionOf[vertex_index] = SIZE_MAX;
+    }
+    _frontierTimes.clear();
+    _frontierVertexIndices.clear();
+    _frontierPositions.clear();
+    for (size_t i=0; i<_events.size(); i++) {
+        int vertex_index = _vertexIndices[i];
+        if (SIZE_MAX == _frontierPositionOf[vertex_index]) {
+            _frontierPositionOf[vertex_index] = i;
+            _frontierTimes.push_back(_times[i]);
+            _frontierVertexIndices.push_back(vertex_index);
+            _frontierPositions.push_back(i);
+        }
+    }
+}
+
+void OoO_EventWindow::Init(const std::vector<OoO_Event*>& orderedEvents)
+{
+    size_t num_events = orderedEvents.size();
+    _times.resize(num_events);
+    _vertexIndices.resize(num_events);
+    _sequenceNums.resize(num_events);
+    _watches.resize(num_events);
+    _events.assign(orderedEvents.begin(), orderedEvents.end());
+    for (size_t i=0; i<num_events; i++) {
+        _times[i] = orderedEvents[i]->getTime();
+        _vertexIndices[i] = orderedEvents[i]->getVertexIndex();
+        _sequenceNums[i] = orderedEvents[i]->getSequenceNum();
+    }
+
+    // Watch the first earlier event blocking each pending event
+    BuildFrontier();
+    size_t frontier_end = 0;
+    for (size_t i=0; i<num_events; i++) {
+        _watches[i] = FindBlocker(0, i, frontier_end);
+        if (frontier_end < _frontierPositions.size() && _frontierPositions[frontier_end] == i) frontier_end++;
+    }
+}
+
+void OoO_EventWindow::Update(const std::vector<OoO_Event*>& removedEvents, std::vector<OoO_Event*>& addedEvents)
+{
+    // Positions of the removed events, in order
+    _removedPositions.clear();
+    for (OoO_Event* removed_event : removedEvents) {
+        _removedPositions.push_back(LowerBound(removed_event->getTime(), removed_event->getVertexIndex(), removed_event->getSequenceNum()));
+    }
+    std::sort(_removedPositions.begin(), _removedPositions.end());
+
+    std::sort(addedEvents.begin(), addedEvents.end(), [](const OoO_Event* first, const OoO_Event* second) {
+        if (first->getTime() != second->getTime()) return first->getTime() < second->getTime();
+        if (first->getVertexIndex() != second->getVertexIndex()) return first->getVertexIndex() < second->getVertexIndex();
+        return first->getSequenceNum() < second->getSequenceNum();
+    });
+
+    // Merge the surviving events with the added events. Watches always point earlier, so each
+    // watched position has been mapped by the time its watchers are copied. Events whose watch
+    // was removed resume their search after it: nothing before the removed watch blocked them.
+    size_t num_old = _events.size();
+    size_t num_events = num_old - _removedPositions.size() + addedEvents.size();
+    _nextTimes.resize(num_events);
+    _nextVertexIndices.resize(num_events);
+    _nextSequenceNums.resize(num_events);
+    _nextWatches.resize(num_events);
+    _nextEvents.resize(num_events);
+    _oldToNew.resize(num_old);
+    _addedPositions.resize(addedEvents.size());
+
+    size_t old_i = 0, added_i = 0, removed_i = 0;
+    for (size_t out=0; out<num_events; out++) {
+        // Skip removed events; their watchers search again from here
+        while (removed_i < _removedPositions.size() && _removedPositions[removed_i] == old_i) {
+            _oldToNew[old_i] = out | _searchFrom;
+            removed_i++;
+            old_i++;
+        }
+
+        bool take_added = false;
+        if (added_i < addedEvents.size()) {
+            if (old_i == num_old) {
+                take_added = true;
+            } else {
+                const OoO_Event* added = addedEvents[added_i];
+                take_added = (added->getTime() != _times[old_i]) ? (added->getTime() < _times[old_i]) :
+                             (added->getVertexIndex() != _vertexIndices[old_i]) ? (added->getVertexIndex() < _vertexIndices[old_i]) :
+                             (added->getSequenceNum() < _sequenceNums[old_i]);
+            }
+        }
+
+        if (take_added) {
+            OoO_Event* added = addedEvents[added_i];
+            _nextTimes[out] = added->getTime();
+            _nextVertexIndices[out] = added->getVertexIndex();
+            _nextSequenceNums[out] = added->getSequenceNum();
+            _nextWatches[out] = _searchFrom;   // Search from position 0
+            _nextEvents[out] = added;
+            _addedPositions[added_i++] = out;
+        } else {
+            size_t watch = _watches[old_i];
+            _nextTimes[out] = _times[old_i];
+            _nextVertexIndices[out] = _vertexIndices[old_i];
+            _nextSequenceNums[out] = _sequenceNums[old_i];
+            _nextWatches[out] = (_ready == watch) ? _ready : _oldToNew[watch];
+            _nextEvents[out] = _events[old_i];
+            _oldToNew[old_i] = out;
+            old_i++;
+        }
+    }
+    _times.swap(_nextTimes);
+    _vertexIndices.swap(_nextVertexIndices);
+    _sequenceNums.swap(_nextSequenceNums);
+    _watches.swap(_nextWatches);
+    _events.swap(_nextEvents);
+    BuildFrontier();
+
+    // An added event behind an earlier pending event at its vertex cannot be a first blocker: that
+    // earlier event blocks everything it blocks. Only added events that joined the frontier are checked.
+    _addedPositions.erase(std::remove_if(_addedPositions.begin(), _addedPositions.end(), [this](size_t position) {
+        return _frontierPositionOf[_vertexIndices[position]] != position;
+    }), _addedPositions.end());
+
+    size_t frontier_end = 0;
+    for (size_t i=0; i<num_events; i++) {
+        size_t watch = _watches[i];
+
+        // Added events before this limit were not covered by the existing watch
+        size_t limit;
+        if (_ready == watch) {
+            limit = i;
+        } else if (0 != (watch & _searchFrom)) {
+            limit = watch & ~_searchFrom;
+            watch = FindBlocker(limit, i, frontier_end);
+        } else {
+            limit = watch;
+        }
+
+        // The first added event that blocks it becomes the watch
+        for (size_t a=0; a<_addedPositions.size() && _addedPositions[a] < limit; a++) {
+            if (Blocks(_addedPositions[a], i)) {
+                watch = _addedPositions[a];
+                break;
+            }
+        }
+        _watches[i] = watch;
+        if (frontier_end < _frontierPositions.size() && _frontierPositions[frontier_end] == i) frontier_end++;
+    }
+}
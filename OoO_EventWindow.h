@@ -0,0 +1,118 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+#include "OoO_ITLProvider.h"
+
+class OoO_Event;
+
+// Contiguous mirror of the pending events in event-set order (timestamp, vertex index, insertion order).
+// Each blocked event watches its first blocking earlier event, in the style of watched literals. When
+// that event leaves the window the search resumes just after it; otherwise only added events ahead of
+// the watch are checked. A first blocker is always the earliest pending event at its vertex, so
+// searches only visit the per-vertex frontier: at most one event per vertex, however deep the
+// window. How the frontier is searched depends on the ITL provider; see FindBlocker.
+class OoO_EventWindow {
+public:
+    // The ITL table must outlive the window
+    OoO_EventWindow(const OoO_ITLProvider& ITL);
+
+    // Load the pending events, given in event-set order, and find their blockers from scratch
+    void Init(const std::vector<OoO_Event*>& orderedEvents);
+
+    // Rebuild the copies derived from the ITL limits after they have been replaced; Init must follow
+    void ReloadITL();
+
+    // Drop executed events and merge in new ones, rechecking only the events those changes affect
+    void Update(const std::vector<OoO_Event*>& removedEvents, std::vector<OoO_Event*>& addedEvents);
+
+    size_t Size() const { return _events.size(); }
+    OoO_Event* getEvent(size_t i) const { return _events[i]; }
+    bool IsReady(size_t i) const { return _ready == _watches[i]; }
+
+    // Name of the kernel set chosen for this CPU
+    const char* getKernelName() const { return _kernelName; }
+
+    // Kernel signature: first i in [begin, end) with time - times[i] >= ITLColumn[vertexIndices[i]], or end if none
+    typedef size_t (*FirstBlockerKernel)(const double* times, const int* vertexIndices,
+                                         size_t begin, size_t end, double time, const float* ITLColumn);
+
+    // Compact-table kernels: limits are 16-bit codes times the scale, or the limits of 8-bit codes
+    typedef size_t (*FirstBlockerKernel16)(const double* times, const int* vertexIndices,
+                                           size_t begin, size_t end, double time, const uint16_t* codeColumn, float scale);
+    typedef size_t (*FirstBlockerKernel8)(const double* times, const int* vertexIndices,
+                                          size_t begin, size_t end, double time, const uint8_t* codeColumn,
+                                          const float* codeLimits);
+
+private:
+    static constexpr size_t _ready = SIZE_MAX;              // Watch value of an event no earlier event blocks
+    static constexpr size_t _searchFrom = SIZE_MAX / 2 + 1; // Flag on a watch that must be searched for from
+                                                            // the position in the low bits
+
+    // Position of the first event not preceding the given key
+    size_t LowerBound(double time, int vertexIndex, size_t sequenceNum) const;
+
+    // Watch value for event i, searching the frontier events from position begin up to frontier
+    // entry frontierEnd, the first one at or after position i
+    size_t FindBlocker(size_t begin, size_t i, size_t frontierEnd) const;
+
+    // First frontier event at positions [begin, i) blocking event i through a listed dependent pair
+    size_t FindDependentBlocker(size_t begin, size_t i) const;
+
+    // Collect the earliest pending event at each vertex, in window order
+    void BuildFrontier();
+
+    // Event at position earlier blocks the event at position later
+    bool Blocks(size_t earlier, size_t later) const {
+        return _times[later] - _times[earlier] >= static_cast<double>(_ITL(_vertexIndices[earlier], _vertexIndices[later]));
+    }
+
+    const float* ITLColumn(int vertexIndex) const { return _ITLColumns->Row(vertexIndex); }
+
+    // Dense copies of the horizon columns listing a quarter of the vertices or more, where the
+    // frontier kernels beat walking the list; other columns have none
+    void BuildHorizonColumns();
+    const float* HorizonColumn(int vertexIndex) const {
+        size_t offset = _horizonColumnOffsets[vertexIndex];
+        return (SIZE_MAX == offset) ? nullptr : &_horizonColumns[offset];
+    }
+
+    const OoO_ITLProvider& _ITL;            // ITL limits, owned by the event set
+    OoO_ITLMatrix _ITL_T;                   // Transposed copy of a dense table, so earlier-vertex lookups read one row
+    const OoO_ITLMatrix* _ITLColumns;       // _ITL_T, or the provider's own transpose when it has one
+    OoO_CompactITL _compactITL_T;           // Transposed copy of a compact table
+    std::vector<float> _horizonColumns;     // Dense horizon columns, unlisted limits at the horizon
+    std::vector<size_t> _horizonColumnOffsets;  // Start of each vertex's dense column, SIZE_MAX if none
+    OoO_DependentPairs _dependents;         // Finite entries of each column of a dense or compact table, or
+                                            // the listed limits of a horizon table
+
+    std::vector<double> _times;             // Event timestamps
+    std::vector<int> _vertexIndices;        // Event vertex indices
+    std::vector<size_t> _sequenceNums;      // Event insertion order
+    std::vector<size_t> _watches;           // Position of the first blocking earlier event, or _ready
+    std::vector<OoO_Event*> _events;        // The events themselves
+
+    // Per-vertex frontier: earliest pending event at each vertex, ordered by window position
+    std::vector<double> _frontierTimes;
+    std::vector<int> _frontierVertexIndices;
+    std::vector<size_t> _frontierPositions;
+    std::vector<size_t> _frontierPositionOf;// Position of each vertex's frontier event, SIZE_MAX if none
+
+    // Merge targets, swapped with the arrays above on each update to avoid reallocating
+    std::vector<double> _nextTimes;
+    std::vector<int> _nextVertexIndices;
+    std::vector<size_t> _nextSequenceNums;
+    std::vector<size_t> _nextWatches;
+    std::vector<OoO_Event*> _nextEvents;
+    std::vector<size_t> _oldToNew;          // New position of each previous position; for removed ones, the
+                                            // position after them flagged with _searchFrom
+    std::vector<size_t> _removedPositions;
+    std::vector<size_t> _addedPositions;    // Positions of the added events that joined the frontier
+
+    FirstBlockerKernel _firstBlockerKernel;
+    FirstBlockerKernel16 _firstBlockerKernel16;
+    FirstBlockerKernel8 _firstBlockerKernel8;
+    const char* _kernelName;
+};
@@ -0,0 +1,209 @@
+#include "OoO_ITLMatrix.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char ITL_FileMagic[8] = {'O', 'o', 'O', '_', 'I', 'T', 'L', '\0'};
+
+void OoO_ITLMatrix::Deleter::operator()(float* data) const
+{
+    if (nullptr != mapBase) {
+        munmap(mapBase, mapBytes);
+    } else {
+        std::free(data);
+    }
+}
+
+OoO_ITLMatrix::OoO_ITLMatrix()
+: _numVertices(0), _stride(0)
+{}
+
+OoO_ITLMatrix::OoO_ITLMatrix(size_t numVertices, float value)
+: _numVertices(numVertices)
+{
+    // Pad rows to whole cache lines
+    const size_t floats_per_line = _alignment / sizeof(float);
+    _stride = (numVertices + floats_per_line - 1) / floats_per_line * floats_per_line;
+
+    size_t num_floats = std::max<size_t>(_stride * numVertices, floats_per_line);
+    float* data = static_cast<float*>(std::aligned_alloc(_alignment, num_floats * sizeof(float)));
+    if (nullptr == data) {
+        std::cerr << "Error: cannot allocate " << numVertices << "x" << numVertices << " ITL matrix" << std::endl;
+        exit(1);
+    }
+    std::fill(data, data + num_floats, value);
+    _data.reset(data);
+}
+
+OoO_ITLMatrix::OoO_ITLMatrix(OoO_ITLMatrix&& other) noexcept
+: _numVertices(other._numVertices), _stride(other._stride), _data(std::move(other._data))
+{
+    other._numVertices = 0;
+    other._stride = 0;
+}
+
+OoO_ITLMatrix& OoO_ITLMatrix::operator=(OoO_ITLMatrix&& other) noexcept
+{
+    if (this != &other) {
+        _numVertices = other._numVertices;
+        _stride = other._stride;
+        _data = std::move(other._data);
+        other._numVertices = 0;
+        other._stride = 0;
+    }
+    return *this;
+}
+
+OoO_ITLMatrix OoO_ITLMatrix::Transposed() const
+{
+    OoO_ITLMatrix transposed(_numVertices, 0);
+    for (size_t j=0; j<_numVertices; j++) {
+        const float* row = Row(j);
+        for (size_t k=0; k<_numVertices; k++) {
+            transposed(k, j) = row[k];
+        }
+    }
+    return transposed;
+}
+
+OoO_ITLMatrix OoO_ITLMatrix::MapFile(const std::string& filename, uint64_t fingerprint)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return OoO_ITLMatrix();
+    }
+    return MapDescriptor(fd, fingerprint);
+}
+
+OoO_ITLMatrix OoO_ITLMatrix::AttachShared(const std::string& name, uint64_t fingerprint)
+{
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0) {
+        return OoO_ITLMatrix();
+    }
+    return MapDescriptor(fd, fingerprint);
+}
+
+bool OoO_ITLMatrix::CreateShared(const std::string& name, uint64_t fingerprint) const
+{
+    int fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0644);
+    if (fd < 0) {
+        return false;
+    }
+
+    FileHeader header = MakeHeader(fingerprint);
+    size_t map_bytes = sizeof(header) + _numVertices * _stride * sizeof(float);
+    void* map_base = (0 == ftruncate(fd, map_bytes)) ? mmap(nullptr, map_bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+                                                     : MAP_FAILED;
+    close(fd);
+    if (MAP_FAILED == map_base) {
+        shm_unlink(name.c_str());
+        return false;
+    }
+    std::memcpy(static_cast<char*>(map_base) + sizeof(header), _data.get(), _numVertices * _stride * sizeof(float));
+    std::memcpy(map_base, &header, sizeof(header));
+    munmap(map_base, map_bytes);
+    return true;
+}
+
+OoO_ITLMatrix OoO_ITLMatrix::MapDescriptor(int fd, uint64_t fingerprint)
+{
+    struct stat file_stat;
+    FileHeader header;
+    bool valid = (0 == fstat(fd, &file_stat)) && (static_cast<size_t>(file_stat.st_size) >= sizeof(header))
+              && (sizeof(header) == pread(fd, &header, sizeof(header), 0))
+              && (0 == std::memcmp(header.magic, ITL_FileMagic, sizeof(ITL_FileMagic)))
+              && (_fileVersion == header.version) && (sizeof(header) == header.headerBytes)
+              && (fingerprint == header.fingerprint) && (0 < header.numVertices)
+              && (header.stride >= header.numVertices) && (0 == header.stride % (_alignment / sizeof(float)))
+              && (static_cast<size_t>(file_stat.st_size) == sizeof(header) + header.numVertices * header.stride * sizeof(float));
+    if (!valid) {
+        close(fd);
+        return OoO_ITLMatrix();
+    }
+
+    size_t map_bytes = static_cast<size_t>(file_stat.st_size);
+    void* map_base = mmap(nullptr, map_bytes, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (MAP_FAILED == map_base) {
+        return OoO_ITLMatrix();
+    }
+
+    OoO_ITLMatrix ITL;
+    ITL._numVertices = header.numVertices;
+    ITL._stride = header.stride;
+    // Mappings are page aligned and the header is one cache line, so the rows keep their alignment
+    float* rows = reinterpret_cast<float*>(static_cast<char*>(map_base) + sizeof(header));
+    ITL._data = std::unique_ptr<float[], Deleter>(rows, Deleter(map_base, map_bytes));
+    return ITL;
+}
+
+OoO_ITLMatrix::FileHeader OoO_ITLMatrix::MakeHeader(uint64_t fingerprint) const
+{
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, ITL_FileMagic, sizeof(ITL_FileMagic));
+    header.version = _fileVersion;
+    header.headerBytes = sizeof(header);
+    header.numVertices = _numVertices;
+    header.stride = _stride;
+    header.fingerprint = fingerprint;
+    return header;
+}
+
+bool OoO_ITLMatrix::WriteFile(const std::string& filename, uint64_t fingerprint) const
+{
+    FileHeader header = MakeHeader(fingerprint);
+
+    // Write to a private file and rename it into place, so concurrent runs never map a partial table
+    std::string temp_filename = filename + ".tmp" + std::to_string(getpid());
+    std::ofstream file(temp_filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(_data.get()), _numVertices * _stride * sizeof(float));
+    file.close();
+    if (!file || 0 != std::rename(temp_filename.c_str(), filename.c_str())) {
+        std::remove(temp_filename.c_str());
+        return false;
+    }
+    return true;
+}
+
+OoO_DependentPairs::OoO_DependentPairs(const OoO_ITLMatrix& ITL)
+: _offsets(ITL.size() + 1, 0)
+{
+    for (size_t k=0; k<ITL.size(); k++) {
+        OoO_ITLMatrix::ColumnView column = ITL.Column(k);
+        for (size_t j=0; j<column.size(); j++) {
+            if (column[j] < std::numeric_limits<float>::max()) {
+                _vertexIndices.push_back(static_cast<int>(j));
+                _limits.push_back(column[j]);
+            }
+        }
+        _offsets[k + 1] = _vertexIndices.size();
+    }
+}
+
+OoO_DependentPairs::OoO_DependentPairs(std::vector<size_t> offsets, std::vector<int> vertexIndices, std::vector<float> limits)
+: _offsets(std::move(offsets)), _vertexIndices(std::move(vertexIndices)), _limits(std::move(limits))
+{}
+
+float OoO_DependentPairs::Limit(size_t j, size_t k, float absentLimit) const
+{
+    auto column_begin = _vertexIndices.begin() + _offsets[k];
+    auto column_end = _vertexIndices.begin() + _offsets[k + 1];
+    auto entry = std::lower_bound(column_begin, column_end, static_cast<int>(j));
+    if (entry == column_end || *entry != static_cast<int>(j)) return absentLimit;
+    return _limits[entry - _vertexIndices.begin()];
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Square float matrix (ITL table or shortest-path times) in one contiguous, cache-line-aligned
+// buffer. Rows are padded to whole cache lines, so every row starts aligned. Move-only: the
+// table is built once and handed down to the event set without copying. A matrix loaded from
+// a binary cache file or a shared-memory segment is a read-only mapping of it.
+class OoO_ITLMatrix {
+public:
+    static constexpr size_t _alignment = 64;   // Cache-line size in bytes
+
+    // Strided view of one column
+    class ColumnView {
+    public:
+        ColumnView(const float* data, size_t stride, size_t size)
+        : _data(data), _stride(stride), _size(size) {}
+        float operator[](size_t i) const { return _data[i * _stride]; }
+        size_t size() const { return _size; }
+    private:
+        const float* _data;
+        size_t _stride;
+        size_t _size;
+    };
+
+    OoO_ITLMatrix();
+    OoO_ITLMatrix(size_t numVertices, float value);
+
+    OoO_ITLMatrix(OoO_ITLMatrix&& other) noexcept;
+    OoO_ITLMatrix& operator=(OoO_ITLMatrix&& other) noexcept;
+    OoO_ITLMatrix(const OoO_ITLMatrix&) = delete;
+    OoO_ITLMatrix& operator=(const OoO_ITLMatrix&) = delete;
+
+    // Number of rows (and columns)
+    size_t size() const { return _numVertices; }
+    bool empty() const { return 0 == _numVertices; }
+
+    // Distance between the starts of consecutive rows, in floats
+    size_t stride() const { return _stride; }
+
+    float& operator()(size_t j, size_t k) { return _data[j * _stride + k]; }
+    float operator()(size_t j, size_t k) const { return _data[j * _stride + k]; }
+
+    // Contiguous row j, aligned to a cache line
+    float* Row(size_t j) { return &_data[j * _stride]; }
+    const float* Row(size_t j) const { return &_data[j * _stride]; }
+
+    ColumnView Column(size_t k) const { return ColumnView(&_data[k], _stride, _numVertices); }
+
+    // New matrix with rows and columns exchanged, so columns can be read as rows
+    OoO_ITLMatrix Transposed() const;
+
+    // Binary cache file: a header, then the padded rows exactly as they are laid out in memory.
+    // MapFile maps the file read-only and returns an empty matrix if it is missing, from another
+    // format version, or was written for a different model fingerprint.
+    static OoO_ITLMatrix MapFile(const std::string& filename, uint64_t fingerprint);
+    bool WriteFile(const std::string& filename, uint64_t fingerprint) const;
+
+    // POSIX shared-memory segment in the cache file format, so concurrent runs of a model can share one
+    // read-only copy. AttachShared maps the named segment, or returns an empty matrix as MapFile does;
+    // CreateShared copies the matrix into a new segment, false if the name is taken or it fails.
+    static OoO_ITLMatrix AttachShared(const std::string& name, uint64_t fingerprint);
+    bool CreateShared(const std::string& name, uint64_t fingerprint) const;
+
+private:
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t headerBytes;
+        uint64_t numVertices;
+        uint64_t stride;
+        uint64_t fingerprint;
+        char padding[24];   // Keeps the rows that follow cache-line aligned
+    };
+    static_assert(sizeof(FileHeader) == _alignment, "ITL file header must fill one cache line");
+    static constexpr uint32_t _fileVersion = 1;
+
+    FileHeader MakeHeader(uint64_t fingerprint) const;
+
+    // Validate and map an open cache file or segment read-only; closes fd
+    static OoO_ITLMatrix MapDescriptor(int fd, uint64_t fingerprint);
+
+    // Frees an aligned buffer, or unmaps a cache file
+    struct Deleter {
+        Deleter() : mapBase(nullptr), mapBytes(0) {}
+        Deleter(void* base, size_t bytes) : mapBase(base), mapBytes(bytes) {}
+        void operator()(float* data) const;
+        void* mapBase;
+        size_t mapBytes;
+    };
+
+    size_t _numVertices;
+    size_t _stride;
+    std::unique_ptr<float[], Deleter> _data;
+};
+
+class OoO_CompactITL;
+
+// Compressed sparse columns of the finite ITL entries: for each later-event vertex k, the earlier-event
+// vertices j that can affect it, with their limits. Infinite entries (j can never affect k) are left out.
+class OoO_DependentPairs {
+public:
+    OoO_DependentPairs() : _offsets(1, 0) {}
+    OoO_DependentPairs(const OoO_ITLMatrix& ITL);
+    OoO_DependentPairs(const OoO_CompactITL& ITL);
+
+    // Columns already in compressed form, each sorted by earlier-event vertex
+    OoO_DependentPairs(std::vector<size_t> offsets, std::vector<int> vertexIndices, std::vector<float> limits);
+
+    // Entries [ColumnBegin(k), ColumnEnd(k)) belong to column k
+    size_t ColumnBegin(size_t k) const { return _offsets[k]; }
+    size_t ColumnEnd(size_t k) const { return _offsets[k + 1]; }
+    size_t ColumnSize(size_t k) const { return _offsets[k + 1] - _offsets[k]; }
+
+    int getVertexIndex(size_t entry) const { return _vertexIndices[entry]; }
+    float getLimit(size_t entry) const { return _limits[entry]; }
+
+    // Limit j-k, or absentLimit if column k does not list vertex j
+    float Limit(size_t j, size_t k, float absentLimit) const;
+
+    size_t NumColumns() const { return _offsets.size() - 1; }
+    size_t NumEntries() const { return _limits.size(); }
+
+private:
+    std::vector<size_t> _offsets;       // Column starts, plus the total at the end
+    std::vector<int> _vertexIndices;    // Earlier-event vertex of each entry
+    std::vector<float> _limits;         // ITL value of each entry
+};
@@ -0,0 +1,72 @@
+#include "OoO_ITLProvider.h"
+
+#include <iostream>
+
+size_t OoO_LatticeLayout::NumNodes() const
+{
+    size_t num_nodes = 1;
+    for (size_t dim : dims) num_nodes *= dim;
+    return num_nodes;
+}
+
+size_t OoO_LatticeLayout::Translate(size_t vertex, size_t offsetNode) const
+{
+    size_t node = vertex / numTypes;
+    size_t translated_node = 0;
+    size_t stride = 1;
+    for (size_t dim : dims) {
+        translated_node += ((node % dim + offsetNode % dim) % dim) * stride;
+        node /= dim;
+        offsetNode /= dim;
+        stride *= dim;
+    }
+    return translated_node * numTypes + vertex % numTypes;
+}
+
+OoO_ITLProvider::OoO_ITLProvider(OoO_ITLMatrix ITL)
+: _kind(Dense), _numVertices(ITL.size()), _matrix(std::move(ITL))
+{}
+
+OoO_ITLProvider::OoO_ITLProvider(OoO_ITLMatrix ITL, OoO_ITLMatrix ITL_T)
+: _kind(Dense), _numVertices(ITL.size()), _matrix(std::move(ITL)), _transposedMatrix(std::move(ITL_T))
+{}
+
+OoO_ITLProvider::OoO_ITLProvider(OoO_CompactITL ITL)
+: _kind(Compact), _numVertices(ITL.size()), _compactITL(std::move(ITL))
+{}
+
+OoO_ITLProvider::OoO_ITLProvider(OoO_DependentPairs limits, float horizon)
+: _kind(Horizon), _numVertices(limits.NumColumns()), _horizonLimits(std::move(limits)), _horizon(horizon)
+{}
+
+OoO_ITLProvider::OoO_ITLProvider(std::shared_ptr<OoO_TiledITL> ITL)
+: _kind(Tiled), _numVertices(ITL->size()), _tiledITL(std::move(ITL))
+{}
+
+OoO_ITLProvider::OoO_ITLProvider(const OoO_LatticeLayout& layout, std::vector<float> offsetLimits)
+: _kind(Lattice), _numVertices(layout.NumNodes() * layout.numTypes), _numTypes(layout.numTypes),
+  _numNodes(layout.NumNodes()), _dims(layout.dims), _offsetLimits(std::move(offsetLimits))
+{
+    if (_offsetLimits.size() != _numTypes * _numTypes * _numNodes) {
+        std::cerr << "Error: lattice ITL table has " << _offsetLimits.size() << " limits, expected "
+                  << _numTypes * _numTypes * _numNodes << std::endl;
+        exit(1);
+    }
+
+    size_t stride = 1;
+    for (size_t dim : _dims) {
+        _nodeStrides.push_back(stride);
+        stride *= dim;
+    }
+
+    _types.resize(_numVertices);
+    _coords.resize(_numVertices * _dims.size());
+    for (size_t v=0; v<_numVertices; v++) {
+        _types[v] = static_cast<uint32_t>(v % _numTypes);
+        size_t node = v / _numTypes;
+        for (size_t d=0; d<_dims.size(); d++) {
+            _coords[v * _dims.size() + d] = static_cast<int32_t>(node % _dims[d]);
+            node /= _dims[d];
+        }
+    }
+}
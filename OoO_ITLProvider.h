@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "OoO_ITLMatrix.h"
+#include "OoO_CompactITL.h"
+#include "OoO_TiledITL.h"
+
+// Vertex numbering of a model that repeats on a periodic lattice (ring, torus): vertex index =
+// node * numTypes + type, and node = x + dims[0] * (y + dims[1] * z) over as many dimensions as given
+struct OoO_LatticeLayout {
+    size_t numTypes = 0;            // Vertices per lattice node
+    std::vector<size_t> dims;       // Nodes along each dimension
+
+    bool empty() const { return 0 == numTypes; }
+    size_t NumNodes() const;
+
+    // Vertex of the same type at the node reached by moving from the vertex's node by the offset node's coordinates
+    size_t Translate(size_t vertex, size_t offsetNode) const;
+};
+
+// ITL limits for the event set. General models use the dense V x V matrix. On a periodic lattice the
+// limit only depends on the two vertex types and the coordinate offset between their nodes, so the
+// provider can instead hold numTypes^2 x nodes limits, which keeps large rings and tori feasible.
+// A compact provider holds the dense table as 16- or 8-bit codes. A horizon provider lists only the
+// limits below a horizon H, per later-event vertex; every other limit reads as H. Events closer than H
+// in time then see their exact limits, and events H or more apart are conservatively dependent. A
+// tiled provider reads the dense table from disk through a tile cache, for tables too large for memory.
+class OoO_ITLProvider {
+public:
+    enum Kind { Dense, Compact, Lattice, Horizon, Tiled };
+
+    explicit OoO_ITLProvider(OoO_ITLMatrix ITL);
+
+    // Dense table with its transpose already at hand, as when both are mapped from shared memory
+    OoO_ITLProvider(OoO_ITLMatrix ITL, OoO_ITLMatrix ITL_T);
+    explicit OoO_ITLProvider(OoO_CompactITL ITL);
+    OoO_ITLProvider(OoO_DependentPairs limits, float horizon);
+    explicit OoO_ITLProvider(std::shared_ptr<OoO_TiledITL> ITL);
+
+    // offsetLimits[(earlier type * numTypes + later type) * nodes + offset node]
+    OoO_ITLProvider(const OoO_LatticeLayout& layout, std::vector<float> offsetLimits);
+
+    Kind getKind() const { return _kind; }
+    bool IsDense() const { return Dense == _kind; }
+    bool IsCompact() const { return Compact == _kind; }
+    bool IsLattice() const { return Lattice == _kind; }
+    bool IsHorizon() const { return Horizon == _kind; }
+    bool IsTiled() const { return Tiled == _kind; }
+    size_t size() const { return _numVertices; }
+
+    // Dense table, empty unless IsDense()
+    const OoO_ITLMatrix& Matrix() const { return _matrix; }
+
+    // Transposed dense table if one was given, else empty
+    const OoO_ITLMatrix& TransposedMatrix() const { return _transposedMatrix; }
+
+    // Compact table, empty unless IsCompact()
+    const OoO_CompactITL& CompactTable() const { return _compactITL; }
+
+    // Listed limits and the horizon, empty unless IsHorizon()
+    const OoO_DependentPairs& HorizonLimits() const { return _horizonLimits; }
+    float getHorizon() const { return _horizon; }
+
+    // Tiled table; only valid if IsTiled()
+    const OoO_TiledITL& TiledTable() const { return *_tiledITL; }
+
+    // ITL limit from earlier-event vertex j to later-event vertex k
+    float operator()(size_t j, size_t k) const {
+        if (Dense == _kind) return _matrix(j, k);
+        if (Compact == _kind) return _compactITL(j, k);
+        if (Horizon == _kind) return _horizonLimits.Limit(j, k, _horizon);
+        if (Tiled == _kind) return (*_tiledITL)(j, k);
+        size_t offset_node = 0;
+        for (size_t d=0; d<_dims.size(); d++) {
+            int32_t offset = _coords[k * _dims.size() + d] - _coords[j * _dims.size() + d];
+            if (offset < 0) offset += static_cast<int32_t>(_dims[d]);
+            offset_node += static_cast<size_t>(offset) * _nodeStrides[d];
+        }
+        return _offsetLimits[(_types[j] * _numTypes + _types[k]) * _numNodes + offset_node];
+    }
+
+private:
+    Kind _kind;
+    size_t _numVertices;
+    OoO_ITLMatrix _matrix;
+    OoO_ITLMatrix _transposedMatrix;
+    OoO_CompactITL _compactITL;
+
+    // Horizon provider
+    OoO_DependentPairs _horizonLimits;
+    float _horizon = 0;
+
+    // Tiled provider
+    std::shared_ptr<OoO_TiledITL> _tiledITL;
+
+    // Lattice provider
+    size_t _numTypes = 0;
+    size_t _numNodes = 0;
+    std::vector<size_t> _dims;
+    std::vector<size_t> _nodeStrides;       // Node index step along each dimension
+    std::vector<uint32_t> _types;           // Type of each vertex
+    std::vector<int32_t> _coords;           // Node coordinates of each vertex, one per dimension
+    std::vector<float> _offsetLimits;
+};
@@ -0,0 +1,150 @@
+#include "OoO_ParametricITL.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <unistd.h>
+
+static const char PITL_FileMagic[8] = {'O', 'o', 'O', '_', 'P', 'I', 'T', 'L'};
+
+bool OoO_ParametricITL::PathForm::Dominates(const PathForm& other) const
+{
+    for (size_t c=0; c<_maxDelayClasses; c++) {
+        if (counts[c] > other.counts[c]) return false;
+    }
+    return true;
+}
+
+bool OoO_ParametricITL::Entry::IsZero() const
+{
+    for (size_t f=0; f<numForms; f++) {
+        bool empty_path = true;
+        for (size_t c=0; c<_maxDelayClasses; c++) {
+            empty_path = empty_path && (0 == forms[f].counts[c]);
+        }
+        if (empty_path) return true;
+    }
+    return false;
+}
+
+bool OoO_ParametricITL::Entry::Covers(const PathForm& form) const
+{
+    for (size_t f=0; f<numForms; f++) {
+        if (forms[f].Dominates(form)) return true;
+    }
+    return false;
+}
+
+bool OoO_ParametricITL::Entry::Add(const PathForm& form)
+{
+    if (Covers(form)) return true;
+
+    // Drop the candidates the new one dominates
+    size_t kept = 0;
+    for (size_t f=0; f<numForms; f++) {
+        if (!form.Dominates(forms[f])) forms[kept++] = forms[f];
+    }
+    if (kept == _maxPathForms) return false;
+    forms[kept++] = form;
+    numForms = static_cast<uint8_t>(kept);
+    return true;
+}
+
+bool OoO_ParametricITL::Entry::Add(const Entry& other)
+{
+    for (size_t f=0; f<other.numForms; f++) {
+        if (!Add(other.forms[f])) return false;
+    }
+    return true;
+}
+
+OoO_ParametricITL::OoO_ParametricITL()
+: _numVertices(0), _numClasses(0)
+{}
+
+OoO_ParametricITL::OoO_ParametricITL(size_t numVertices, size_t numClasses)
+: _numVertices(numVertices), _numClasses(numClasses), _entries(numVertices * numVertices)
+{
+    for (Entry& entry : _entries) {
+        entry.numForms = 0;
+    }
+}
+
+OoO_ITLMatrix OoO_ParametricITL::Evaluate(const std::vector<float>& classDelays) const
+{
+    OoO_ITLMatrix ITL(_numVertices, std::numeric_limits<float>::max());
+    #pragma omp parallel for schedule(static)
+    for (size_t j=0; j<_numVertices; j++) {
+        float* ITL_j = ITL.Row(j);
+        for (size_t k=0; k<_numVertices; k++) {
+            const Entry& entry = (*this)(j, k);
+            if (!entry.HasForms()) continue;
+
+            double limit = std::numeric_limits<double>::max();
+            for (size_t f=0; f<entry.numForms; f++) {
+                double path_delay = 0;
+                for (size_t c=0; c<_numClasses; c++) {
+                    path_delay += entry.forms[f].counts[c] * static_cast<double>(classDelays[c]);
+                }
+                limit = std::min(limit, path_delay);
+            }
+            float limit_f = static_cast<float>(limit);
+            if (static_cast<double>(limit_f) > limit) {
+                limit_f = std::nextafter(limit_f, 0.0f);
+            }
+            ITL_j[k] = limit_f;
+        }
+    }
+    return ITL;
+}
+
+OoO_ParametricITL OoO_ParametricITL::ReadFile(const std::string& filename, uint64_t fingerprint)
+{
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        return OoO_ParametricITL();
+    }
+
+    FileHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    if (!file || 0 != std::memcmp(header.magic, PITL_FileMagic, sizeof(PITL_FileMagic)) ||
+        _fileVersion != header.version || fingerprint != header.fingerprint ||
+        0 == header.numVertices || header.numClasses > _maxDelayClasses) {
+        return OoO_ParametricITL();
+    }
+
+    OoO_ParametricITL parametric(header.numVertices, header.numClasses);
+    file.read(reinterpret_cast<char*>(parametric._entries.data()), parametric._entries.size() * sizeof(Entry));
+    if (!file) {
+        return OoO_ParametricITL();
+    }
+    return parametric;
+}
+
+bool OoO_ParametricITL::WriteFile(const std::string& filename, uint64_t fingerprint) const
+{
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, PITL_FileMagic, sizeof(PITL_FileMagic));
+    header.version = _fileVersion;
+    header.numClasses = static_cast<uint32_t>(_numClasses);
+    header.numVertices = _numVertices;
+    header.fingerprint = fingerprint;
+
+    // Write to a private file and rename it into place, so concurrent runs never read a partial table
+    std::string temp_filename = filename + ".tmp" + std::to_string(getpid());
+    std::ofstream file(temp_filename, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(_entries.data()), _entries.size() * sizeof(Entry));
+    file.close();
+    if (!file || 0 != std::rename(temp_filename.c_str(), filename.c_str())) {
+        std::remove(temp_filename.c_str());
+        return false;
+    }
+    return true;
+}
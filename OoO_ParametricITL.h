@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "OoO_ITLMatrix.h"
+
+// ITL table as a function of the edge delays. Every ITL value is the length of a shortest path, a sum of
+// edge minima, and each minimum is the delay of its edge's class. So each entry keeps the class counts of
+// its candidate paths: those no other path beats on every class, as any of them can be the shortest for
+// some delays. Built once per topology, it is evaluated for each set of class delays.
+class OoO_ParametricITL {
+public:
+    static constexpr size_t _maxDelayClasses = 2;
+    static constexpr size_t _maxPathForms = 4;
+
+    // Number of edges of each delay class along one path
+    struct PathForm {
+        uint16_t counts[_maxDelayClasses];
+        bool Dominates(const PathForm& other) const;    // No more edges of any class
+    };
+
+    // Candidate paths of one entry; none if the later vertex cannot be reached
+    struct Entry {
+        uint8_t numForms;
+        PathForm forms[_maxPathForms];
+
+        bool HasForms() const { return 0 != numForms; }
+        bool IsZero() const;        // Holds the empty path, so the limit is 0 for any delays
+        bool Covers(const PathForm& form) const;    // Some candidate dominates the form
+
+        // Add a candidate (or all of another entry's), dropping dominated ones; false if the entry overflows
+        bool Add(const PathForm& form);
+        bool Add(const Entry& other);
+    };
+
+    OoO_ParametricITL();
+    OoO_ParametricITL(size_t numVertices, size_t numClasses);
+
+    size_t size() const { return _numVertices; }
+    bool empty() const { return 0 == _numVertices; }
+    size_t getNumClasses() const { return _numClasses; }
+
+    Entry& operator()(size_t j, size_t k) { return _entries[j * _numVertices + k]; }
+    const Entry& operator()(size_t j, size_t k) const { return _entries[j * _numVertices + k]; }
+
+    // ITL table for the given delay of each class. Limits are rounded down to float, so none exceeds its path delay.
+    OoO_ITLMatrix Evaluate(const std::vector<float>& classDelays) const;
+
+    // Cache file; ReadFile returns an empty table if the file is missing, from another version, or for another topology
+    static OoO_ParametricITL ReadFile(const std::string& filename, uint64_t fingerprint);
+    bool WriteFile(const std::string& filename, uint64_t fingerprint) const;
+
+private:
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t numClasses;
+        uint64_t numVertices;
+        uint64_t fingerprint;
+    };
+    static constexpr uint32_t _fileVersion = 1;
+
+    size_t _numVertices;
+    size_t _numClasses;
+    std::vector<Entry> _entries;
+};
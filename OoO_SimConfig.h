@@ -0,0 +1,9 @@
+#pragma once
+
+#include <string>
+
+// Read a model input file, build the model and run it. With ITL_Only the model is built without traces,
+// and only its ITL table is computed and cached; with ITL_CheckChanges as well, the maintained ITL table
+// is checked against MakeITL under that many topology changes per round instead. Returns false if the
+// file cannot be opened.
+bool RunInputFile(const std::string& inputFilename, bool ITL_Only, size_t ITL_CheckChanges = 0);
@@ -4,16 +4,28 @@
 #include <iostream>
 #include <fstream>
 
-OoO_SimExec::OoO_SimExec(int numThreads, std::vector<std::vector<float>> ITL, double maxSimTime, int distSeed, int numSerialOoO_Execs)
-: _run(true), _simTime(0), _numEventsExecuted(0), _distSeed(distSeed), _numSerialOoO_Execs(numSerialOoO_Execs)
+OoO_SimExec::OoO_SimExec(int numThreads, OoO_ITLProvider ITL, double maxSimTime, int distSeed, int numSerialOoO_Execs,
+                         const OoO_SimOptions& options)
+: _run(true), _simTime(0), _numEventsExecuted(0), _distSeed(distSeed), _numSerialOoO_Execs(numSerialOoO_Execs),
+  _numThreads(numThreads)
 {
-    // Initialize the event set with the ITL table and maximum simulation time
-    _ES = std::make_unique<OoO_EventSet>(ITL, maxSimTime);
+    if (!OoO_ThreadPool::ParseScheduler(options.threadScheduler, _threadScheduler)) {
+        std::cerr << "Error: unknown thread scheduler '" << options.threadScheduler << "' (expected stealing or shared)" << std::endl;
+        exit(1);
+    }
+    
+    // Initialize the event set with the ITL table, maximum simulation time and event-set backend
+    _ES = std::make_unique<OoO_EventSet>(std::move(ITL), maxSimTime, options);
+}
+
+void OoO_SimExec::ScheduleInitEvents(OoO_EventSink& initEvents)
+{
+    _ES->AddEvents(initEvents);
 }
 
-void OoO_SimExec::ScheduleInitEvent(OoO_Event* newEvent)
+void OoO_SimExec::PublishITL(OoO_ITLProvider ITL)
 {
-    _ES->AddEvent(newEvent);
+    _ES->PublishITL(std::move(ITL));
 }
 
 void OoO_SimExec::RunSerialSim(std::string execOrderFilename)
@@ -50,4 +62,65 @@ void OoO_SimExec::RunSerialSim(std::string execOrderFilename)
               duration_OoO.count()/1e6, _numEventsExecuted.load(), _ES->GetReadyEventsMeanSize(), 
               _ES->GetE_SizesMeanSize(), _ES->GetE_RangesMeanRange());
     }
+}
+
+void OoO_SimExec::RunParallelSim(std::string execOrderFilename)
+{
+    // In-order execution has no ready-event sets to spread across threads
+    if (0 == _numSerialOoO_Execs || _numThreads < 2) {
+        RunSerialSim(execOrderFilename);
+        return;
+    }
+
+    std::cout << "parallel sim: OoO_SimExec " << _numSerialOoO_Execs << ", threads " << _numThreads << std::endl;
+
+    if (!_threadPool) {
+        _threadPool = std::make_unique<OoO_ThreadPool>(_numThreads, _threadScheduler);
+    }
+
+    auto start_OoO = std::chrono::high_resolution_clock::now();
+    _ES->ExecuteParallel_OoO(_simTime, _numEventsExecuted, _distSeed, _numSerialOoO_Execs, execOrderFilename, *_threadPool);
+
+    auto stop_OoO = std::chrono::high_resolution_clock::now();
+    auto duration_OoO = std::chrono::duration_cast<std::chrono::microseconds>(stop_OoO - start_OoO);
+
+    printf("OoO SIMULATION FINISHED\n");
+    printf("OoO time %lf, events executed %d, event set (%d):\n", 
+          _simTime, _numEventsExecuted.load(), _ES->GetSize());
+    printf("PARALLEL OoO runtime: %lf, threads: %d, num OoO events executed: %d, mean size ready events: %lf, mean E size: %lf, mean E range: %lf\n", 
+          duration_OoO.count()/1e6, _numThreads, _numEventsExecuted.load(), _ES->GetReadyEventsMeanSize(), 
+          _ES->GetE_SizesMeanSize(), _ES->GetE_RangesMeanRange());
+    if (OoO_ThreadPool::WorkStealing == _threadScheduler) {
+        printf("Work stealing: %zu ready events stolen\n", _threadPool->getNumSteals());
+    }
+}
+
+void OoO_SimExec::RunPipelinedSim(std::string execOrderFilename)
+{
+    // In-order execution has no ready events to overlap with, and comparisons against the in-order
+    // execution order follow the batches of the batch executor
+    if (0 == _numSerialOoO_Execs || !execOrderFilename.empty()) {
+        RunParallelSim(execOrderFilename);
+        return;
+    }
+
+    std::cout << "pipelined sim: OoO_SimExec " << _numSerialOoO_Execs << ", threads " << _numThreads << std::endl;
+
+    // One thread more than the workers: the calling thread finds and commits events
+    if (!_threadPool || _threadPool->getNumThreads() != static_cast<size_t>(_numThreads) + 1) {
+        _threadPool = std::make_unique<OoO_ThreadPool>(_numThreads + 1, _threadScheduler);
+    }
+
+    auto start_OoO = std::chrono::high_resolution_clock::now();
+    _ES->ExecutePipelined_OoO(_simTime, _numEventsExecuted, _distSeed, _numSerialOoO_Execs, *_threadPool);
+
+    auto stop_OoO = std::chrono::high_resolution_clock::now();
+    auto duration_OoO = std::chrono::duration_cast<std::chrono::microseconds>(stop_OoO - start_OoO);
+
+    printf("OoO SIMULATION FINISHED\n");
+    printf("OoO time %lf, events executed %d, event set (%d):\n", 
+          _simTime, _numEventsExecuted.load(), _ES->GetSize());
+    printf("PIPELINED OoO runtime: %lf, threads: %d, num OoO events executed: %d, mean size ready events: %lf, mean E size: %lf, mean E range: %lf\n", 
+          duration_OoO.count()/1e6, _numThreads, _numEventsExecuted.load(), _ES->GetReadyEventsMeanSize(), 
+          _ES->GetE_SizesMeanSize(), _ES->GetE_RangesMeanRange());
 }
\ No newline at end of file
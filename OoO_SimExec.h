@@ -1,17 +1,33 @@
 #pragma once
 
 #include "OoO_EventSet.h"
+#include "OoO_ThreadPool.h"
+#include "OoO_SimOptions.h"
 
 class OoO_SimExec {
 public:
     // Constructor takes ITL table, simulation time limit, and OoO execution parameters
-    OoO_SimExec(int numThreads, std::vector<std::vector<float>> ITL, double maxSimTime, int distSeed, int numSerialOoO_Execs);
+    OoO_SimExec(int numThreads, OoO_ITLProvider ITL, double maxSimTime, int distSeed, int numSerialOoO_Execs,
+                const OoO_SimOptions& options);
     
-    // Add an initial event to the event set
-    void ScheduleInitEvent(OoO_Event* newEvent);
+    // Add the initial events to the event set
+    void ScheduleInitEvents(OoO_EventSink& initEvents);
+    
+    // Hand new ITL limits to the event set, which switches to them between batches of events
+    void PublishITL(OoO_ITLProvider ITL);
+    
+    // Largest timestamp range of the pending events seen so far
+    double GetE_RangesMaxRange() const { return _ES->GetE_RangesMaxRange(); }
     
     // Run the serial simulation
     void RunSerialSim(std::string execOrderFilename);
+    
+    // Run the simulation, executing ready events on a pool of numThreads threads
+    void RunParallelSim(std::string execOrderFilename);
+    
+    // Run the simulation with ready-event discovery on this thread overlapped with execution on
+    // numThreads worker threads
+    void RunPipelinedSim(std::string execOrderFilename);
 
 private:
     bool _run;                                  // Flag to control simulation execution
@@ -20,4 +36,7 @@ private:
     std::unique_ptr<OoO_EventSet> _ES;          // Event set containing all events
     int _distSeed;                              // Seed for random distributions
     int _numSerialOoO_Execs;                    // Controls OoO execution behavior
+    const int _numThreads;                      // Number of threads for parallel execution
+    OoO_ThreadPool::Scheduler _threadScheduler; // How the pool spreads ready events over its threads
+    std::unique_ptr<OoO_ThreadPool> _threadPool;// Persistent worker threads for parallel execution
 };
\ No newline at end of file
@@ -1,11 +1,28 @@
 #include "OoO_SimModel.h"
 #include "Dist.h"
+#include "OoO_BitMatrix.h"
+#include "OoO_ParametricITL.h"
+#include "OoO_TiledITL.h"
 
 #include <omp.h>
 #include <iostream>
 #include <fstream>
 #include <algorithm>
 #include <filesystem>
+#include <cmath>
+#include <cstring>
+#include <iomanip>
+#include <numeric>
+#include <random>
+#include <set>
+#include <tuple>
+#include <thread>
+#include <unordered_set>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 namespace fs = std::filesystem;
 
 // Helper function to get the executable path
@@ -17,14 +34,50 @@ std::string getExecutablePath()
     return executablePath.substr(0, executablePath.find_last_of("/"));
 }
 
-OoO_SimModel::OoO_SimModel(double maxSimTime, size_t numThreads, size_t distSeed, int numSerialOoO_Execs, std::string traceFolderName)
+// Path of a cached table in ITL_tables, named by the fingerprint of what it was built from
+static std::string CachedTablePath(uint64_t fingerprint, const std::string& extension)
+{
+    char fingerprint_hex[17];
+    snprintf(fingerprint_hex, sizeof(fingerprint_hex), "%016llx", static_cast<unsigned long long>(fingerprint));
+    return getExecutablePath() + "/ITL_tables/" + fingerprint_hex + extension;
+}
+
+// Whether fd is the shared-memory object currently linked under name, rather than one since unlinked
+static bool IsLinkedSharedObject(int fd, const std::string& name)
+{
+    int linked_fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (linked_fd < 0) return false;
+    struct stat fd_stat, linked_stat;
+    bool linked = (0 == fstat(fd, &fd_stat) && 0 == fstat(linked_fd, &linked_stat) &&
+                   fd_stat.st_dev == linked_stat.st_dev && fd_stat.st_ino == linked_stat.st_ino);
+    close(linked_fd);
+    return linked;
+}
+
+OoO_SimModel::OoO_SimModel(double maxSimTime, size_t numThreads, size_t distSeed, int numSerialOoO_Execs, std::string traceFolderName,
+                           const OoO_SimOptions& options)
 : _numVertices(0), _maxSimTime(maxSimTime), _numThreads(numThreads), _distSeed(distSeed), 
-  _numSerialOoO_Execs(numSerialOoO_Execs), _traceFolderName(traceFolderName)
+  _numSerialOoO_Execs(numSerialOoO_Execs), _traceFolderName(options.ITL_Only ? "" : traceFolderName), _options(options)
 {
     std::cout << "OoO_SimModel " << numSerialOoO_Execs << std::endl;
     std::cout << "OpenMP num threads: " << omp_get_max_threads() << std::endl;
 }
 
+OoO_SimModel::~OoO_SimModel()
+{
+    // The last run using a shared ITL table removes it: only then can its lock object be taken
+    // exclusively while this run still holds it shared
+    if (_sharedITL_LockFd < 0) return;
+    const std::string lock_name = _sharedITL_Name + ".lock";
+    if (0 == flock(_sharedITL_LockFd, LOCK_EX | LOCK_NB) && IsLinkedSharedObject(_sharedITL_LockFd, lock_name)) {
+        shm_unlink(_sharedITL_Name.c_str());
+        shm_unlink((_sharedITL_Name + "_T").c_str());
+        shm_unlink(lock_name.c_str());
+        std::cout << "ITL table removed from shared memory " << _sharedITL_Name << "\n";
+    }
+    close(_sharedITL_LockFd);
+}
+
 void OoO_SimModel::setNumVertices(size_t numVertices)
 {
     if (0 == _numVertices) {
@@ -35,95 +88,350 @@ void OoO_SimModel::setNumVertices(size_t numVertices)
 
 size_t OoO_SimModel::getNumVertices() { return _numVertices; }
 
-void OoO_SimModel::Init_OoO(std::string tableFilename)
+void OoO_SimModel::Init_OoO(std::string tableFilename, const OoO_LatticeLayout& layout)
+{
+    // ITL_Gen -check builds no table of its own
+    if (_options.ITLCheckChanges > 0) {
+        CheckMaintainedITL(_options.ITLCheckChanges);
+        return;
+    }
+    
+    const std::string& provider = _options.ITLProvider;
+    if ("auto" != provider && "matrix" != provider && "lattice" != provider && "tiled" != provider) {
+        std::cerr << "Error: unknown ITL provider '" << provider << "' (expected auto, matrix, lattice or tiled)" << std::endl;
+        exit(1);
+    }
+    if ("lattice" == provider && layout.empty()) {
+        std::cerr << "Warning: model has no lattice layout, using the ITL matrix" << std::endl;
+    }
+    if ("off" != _options.ITLHorizon) {
+        if (_options.ITL_Only) {
+            std::cout << "Horizon ITL limits are built at startup, nothing to cache" << std::endl;
+            return;
+        }
+        float horizon = ITL_Horizon();
+        _ITLProviderKind = "horizon";
+        _simExec = std::make_unique<OoO_SimExec>(_numThreads, OoO_ITLProvider(MakeHorizonITL(horizon), horizon),
+                                                 _maxSimTime, _distSeed, _numSerialOoO_Execs, _options);
+        return;
+    }
+    
+    OoO_CompactITL::Encoding encoding;
+    if ("float" != _options.ITLEncoding && !OoO_CompactITL::ParseEncoding(_options.ITLEncoding, encoding)) {
+        std::cerr << "Error: unknown ITL encoding '" << _options.ITLEncoding << "' (expected float, fixed16 or quantum8)" << std::endl;
+        exit(1);
+    }
+    
+    bool use_lattice = !layout.empty() && ("lattice" == provider || ("auto" == provider && _numVertices >= _latticeITL_MinVertices));
+    if (use_lattice) {
+        if (_options.ITL_Only) {
+            std::cout << "Lattice ITL limits are built at startup, nothing to cache" << std::endl;
+            return;
+        }
+        if ("float" != _options.ITLEncoding) {
+            std::cerr << "Warning: ITL encoding '" << _options.ITLEncoding << "' applies to dense tables only" << std::endl;
+        }
+        std::vector<float> offset_limits;
+        if (MakeLatticeITL(layout, offset_limits)) {
+            _ITLProviderKind = "lattice";
+            _simExec = std::make_unique<OoO_SimExec>(_numThreads, OoO_ITLProvider(layout, std::move(offset_limits)),
+                                                     _maxSimTime, _distSeed, _numSerialOoO_Execs, _options);
+            return;
+        }
+    }
+    
+    // Binary tables are named by the model fingerprint, so a changed model never picks up a stale table
+    uint64_t fingerprint = ModelFingerprint(true);
+    
+    // Tables too large for memory are generated to disk in tiles and read through a tile cache
+    const double dense_bytes = static_cast<double>(_numVertices) * _numVertices * sizeof(float);
+    const double memory_bytes = static_cast<double>(sysconf(_SC_PHYS_PAGES)) * sysconf(_SC_PAGE_SIZE);
+    if ("tiled" == provider || ("auto" == provider && dense_bytes > _tiledITL_MemoryFraction * memory_bytes)) {
+        if ("float" != _options.ITLEncoding) {
+            std::cerr << "Warning: ITL encoding '" << _options.ITLEncoding << "' applies to in-memory tables only" << std::endl;
+        }
+        std::string tiled_path = CachedTablePath(fingerprint, ".titl");
+        std::cout << tiled_path << std::endl;
+        const size_t cache_bytes = _options.ITLTileCacheMB << 20;
+        std::shared_ptr<OoO_TiledITL> tiled_ITL = OoO_TiledITL::Open(tiled_path, fingerprint, cache_bytes);
+        if (!tiled_ITL) {
+            if (!MakeTiledITL(tiled_path, fingerprint) ||
+                !(tiled_ITL = OoO_TiledITL::Open(tiled_path, fingerprint, cache_bytes))) {
+                std::cerr << "Error: failed to write tiled ITL table " << tiled_path << std::endl;
+                exit(1);
+            }
+        } else {
+            std::cout << "Tiled ITL table opened from " << tiled_path << "\n";
+        }
+        if (_options.ITL_Only) return;
+        
+        printf("ITL tile cache: %zu tiles of %zu x %zu limits\n", tiled_ITL->getCacheTiles(),
+               OoO_TiledITL::_tileSize, OoO_TiledITL::_tileSize);
+        _ITLProviderKind = "tiled";
+        _simExec = std::make_unique<OoO_SimExec>(_numThreads, OoO_ITLProvider(std::move(tiled_ITL)),
+                                                 _maxSimTime, _distSeed, _numSerialOoO_Execs, _options);
+        return;
+    }
+    
+    // Concurrent runs of the model can share one copy of the table and its transpose
+    if (_options.ITLShared && !_options.ITL_Only && "float" != _options.ITLEncoding) {
+        std::cerr << "Warning: itl_shared shares float tables only, each run encodes its own "
+                  << _options.ITLEncoding << " table" << std::endl;
+    } else if (_options.ITLShared && !_options.ITL_Only) {
+        OoO_ITLMatrix ITL_T;
+        OoO_ITLMatrix ITL_table = SharedITL(tableFilename, fingerprint, ITL_T);
+        _ITLProviderKind = "matrix";
+        _simExec = std::make_unique<OoO_SimExec>(_numThreads, DenseITLProvider(std::move(ITL_table), std::move(ITL_T)),
+                                                 _maxSimTime, _distSeed, _numSerialOoO_Execs, _options);
+        return;
+    }
+    
+    OoO_ITLMatrix ITL_table = LoadITL(tableFilename, fingerprint);
+    if (_options.ITL_Only) return;
+    
+    _ITLProviderKind = "matrix";
+    _simExec = std::make_unique<OoO_SimExec>(_numThreads, DenseITLProvider(std::move(ITL_table)), _maxSimTime, _distSeed,
+                                             _numSerialOoO_Execs, _options);
+}
+
+OoO_ITLMatrix OoO_SimModel::LoadITL(const std::string& tableFilename, uint64_t fingerprint)
 {
-    std::vector<std::vector<float>> ITL_table;
-    std::string table_path = getExecutablePath() + "/ITL_tables/" + tableFilename;
+    std::string table_path = CachedTablePath(fingerprint, ".itl");
     std::cout << table_path << std::endl;
     
-    if (!fs::exists(table_path)) {
-        ITL_table = MakeITL(tableFilename);
+    OoO_ITLMatrix ITL_table = OoO_ITLMatrix::MapFile(table_path, fingerprint);
+    if (ITL_table.empty()) {
+        // Models whose edge delays come from a few parameters share one parametric table per topology
+        std::vector<float> class_delays;
+        if (EdgeDelayClasses(class_delays)) {
+            ITL_table = EvaluateParametricITL(class_delays);
+        }
+        if (ITL_table.empty()) {
+            ITL_table = MakeITL();
+        }
+        WriteITLTableToCSV(ITL_table, tableFilename);
+        if (!ITL_table.WriteFile(table_path, fingerprint)) {
+            std::cerr << "Failed to write ITL table " << table_path << "\n";
+        }
     } else {
-        ITL_table = ReadITLTableFromCSV(tableFilename);
+        std::cout << "Data successfully mapped from " << table_path << "\n";
     }
+    return ITL_table;
+}
+
+OoO_ITLMatrix OoO_SimModel::SharedITL(const std::string& tableFilename, uint64_t fingerprint, OoO_ITLMatrix& ITL_T)
+{
+    char fingerprint_hex[17];
+    snprintf(fingerprint_hex, sizeof(fingerprint_hex), "%016llx", static_cast<unsigned long long>(fingerprint));
+    const std::string name = std::string("/OoO_ITL_") + fingerprint_hex;
+    const std::string name_T = name + "_T";
+    const std::string lock_name = name + ".lock";
     
-    _simExec = std::make_unique<OoO_SimExec>(_numThreads, ITL_table, _maxSimTime, _distSeed, _numSerialOoO_Execs);
+    // Runs hold the table's lock object shared for as long as they use the table and publish holding it
+    // exclusively, so concurrent first runs build the table once and no run maps a partly written
+    // segment. The last run to finish unlinks the segments and the lock object, so a run that locked a
+    // lock object unlinked meanwhile starts over with a new one.
+    OoO_ITLMatrix ITL_table;
+    int lock_fd = -1;
+    while (lock_fd < 0) {
+        lock_fd = shm_open(lock_name.c_str(), O_RDWR | O_CREAT, 0644);
+        if (lock_fd < 0) {
+            std::cerr << "Warning: cannot open shared-memory lock " << lock_name << ", using a private ITL table" << std::endl;
+            return LoadITL(tableFilename, fingerprint);
+        }
+        flock(lock_fd, LOCK_SH);
+        if (!IsLinkedSharedObject(lock_fd, lock_name)) {
+            close(lock_fd);
+            lock_fd = -1;
+            continue;
+        }
+        ITL_table = OoO_ITLMatrix::AttachShared(name, fingerprint);
+        ITL_T = OoO_ITLMatrix::AttachShared(name_T, fingerprint);
+        if (!ITL_table.empty() && !ITL_T.empty()) {
+            std::cout << "ITL table attached from shared memory " << name << "\n";
+            break;
+        }
+        
+        flock(lock_fd, LOCK_EX);
+        if (!IsLinkedSharedObject(lock_fd, lock_name)) {
+            close(lock_fd);
+            lock_fd = -1;
+            continue;
+        }
+        ITL_table = OoO_ITLMatrix::AttachShared(name, fingerprint);
+        ITL_T = OoO_ITLMatrix::AttachShared(name_T, fingerprint);
+        if (ITL_table.empty() || ITL_T.empty()) {
+            // Segments left behind by a run that failed while publishing are replaced
+            shm_unlink(name.c_str());
+            shm_unlink(name_T.c_str());
+            OoO_ITLMatrix built = LoadITL(tableFilename, fingerprint);
+            OoO_ITLMatrix built_T = built.Transposed();
+            if (built.CreateShared(name, fingerprint) && built_T.CreateShared(name_T, fingerprint)) {
+                ITL_table = OoO_ITLMatrix::AttachShared(name, fingerprint);
+                ITL_T = OoO_ITLMatrix::AttachShared(name_T, fingerprint);
+            }
+            if (ITL_table.empty() || ITL_T.empty()) {
+                std::cerr << "Warning: cannot publish ITL table to shared memory " << name << ", using a private copy" << std::endl;
+                shm_unlink(name.c_str());
+                shm_unlink(name_T.c_str());
+                ITL_table = std::move(built);
+                ITL_T = std::move(built_T);
+            } else {
+                std::cout << "ITL table published to shared memory " << name << "\n";
+            }
+        } else {
+            std::cout << "ITL table attached from shared memory " << name << "\n";
+        }
+        flock(lock_fd, LOCK_SH);
+    }
+    _sharedITL_LockFd = lock_fd;
+    _sharedITL_Name = name;
+    return ITL_table;
+}
+
+OoO_ITLProvider OoO_SimModel::DenseITLProvider(OoO_ITLMatrix ITL, OoO_ITLMatrix ITL_T) const
+{
+    OoO_CompactITL::Encoding encoding;
+    if (!OoO_CompactITL::ParseEncoding(_options.ITLEncoding, encoding)) {
+        if (!ITL_T.empty()) return OoO_ITLProvider(std::move(ITL), std::move(ITL_T));
+        return OoO_ITLProvider(std::move(ITL));
+    }
+
+    float quantum = (OoO_CompactITL::Quantum8 == encoding) ? DelayQuantum() : 0;
+    OoO_CompactITL compact_ITL(ITL, encoding, quantum);
+    printf("ITL table encoded as %s, scale %g\n", _options.ITLEncoding.c_str(), compact_ITL.getScale());
+    if (compact_ITL.getNumClamped() > 0) {
+        std::cerr << "Warning: " << compact_ITL.getNumClamped() << " ITL limits exceed the " << _options.ITLEncoding
+                  << " range and were lowered to its largest value" << std::endl;
+    }
+    return OoO_ITLProvider(std::move(compact_ITL));
+}
+
+float OoO_SimModel::DelayQuantum() const
+{
+    double max_delay = 0;
+    for (const auto& vertex_edges : _edges) {
+        for (const auto& edge : vertex_edges) max_delay = std::max(max_delay, static_cast<double>(edge.getMinDist()));
+    }
+
+    // Euclid's algorithm on the delays, taking remainders within float precision of the divisor as zero
+    const double tolerance = max_delay * 1e-6;
+    double quantum = 0;
+    for (const auto& vertex_edges : _edges) {
+        for (const auto& edge : vertex_edges) {
+            double delay = edge.getMinDist();
+            if (delay <= 0) continue;
+            double a = std::max(quantum, delay);
+            double b = std::min(quantum, delay);
+            while (b > tolerance) {
+                double remainder = std::fmod(a, b);
+                if (b - remainder <= tolerance) remainder = 0;
+                a = b;
+                b = remainder;
+            }
+            quantum = a;
+        }
+    }
+    return static_cast<float>(quantum);
+}
+
+uint64_t OoO_SimModel::ModelFingerprint(bool withDelays) const
+{
+    // FNV-1a over everything the ITL table is derived from: edges with their minimum delays (or only
+    // their delay classes), and each vertex's input and output SVs. Counts are hashed too, so list
+    // boundaries cannot shift.
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](uint64_t value) {
+        for (size_t b=0; b<sizeof(value); b++) {
+            hash ^= (value >> (8 * b)) & 0xff;
+            hash *= 1099511628211ull;
+        }
+    };
+    
+    mix(withDelays);
+    mix(_numVertices);
+    for (size_t i=0; i<_numVertices; i++) {
+        mix(_edges.at(i).size());
+        for (const auto& edge : _edges.at(i)) {
+            uint32_t min_dist_bits;
+            float min_dist = edge.getMinDist();
+            std::memcpy(&min_dist_bits, &min_dist, sizeof(min_dist_bits));
+            mix(edge.getOrigVertexIndex());
+            mix(edge.getTermVertexIndex());
+            mix(withDelays ? min_dist_bits : static_cast<uint64_t>(edge.getDelayClass()));
+        }
+        for (const std::vector<size_t>* SVs : {&_Is.at(i), &_Os.at(i)}) {
+            mix(SVs->size());
+            for (size_t sv : *SVs) mix(sv);
+        }
+    }
+    return hash;
 }
 
 // ITL function in OoO_SimModel Class
-std::vector<std::vector<float>> OoO_SimModel::MakeITL(std::string tableFilename)
+OoO_ITLMatrix OoO_SimModel::MakeITL()
 {
     // ITL, acquire input data
     // get shortest paths, from simulation model
-    std::vector<std::vector<float>> shortest_paths = FloydWarshall();
+    OoO_ITLMatrix shortest_paths = ShortestPaths();
 
     auto ITL_table_p1_gen_start = std::chrono::high_resolution_clock::now();
     
     // ITL, Phase One
-    std::vector<std::vector<float>> ITL(_numVertices, std::vector<float>(_numVertices, 0));
+    OoO_ITLMatrix ITL(_numVertices, 0);
     
-    // reachable vertices
-    std::vector<std::vector<size_t>> Rs(_numVertices);
+    // reachable vertices, one bitset per vertex
+    OoO_BitMatrix Rs(_numVertices, _numVertices);
     
     // for each vertex l, get reachable vertices
     for (size_t l=0; l<_numVertices; l++) {
-        std::vector<size_t> l_m_paths;
-        l_m_paths.reserve(_numVertices);
+        const float* l_paths = shortest_paths.Row(l);
         for (size_t m=0; m<_numVertices; m++) {
-            if (shortest_paths.at(l).at(m) < std::numeric_limits<float>::max()) {
-                l_m_paths.push_back(m);
+            if (l_paths[m] < std::numeric_limits<float>::max()) {
+                Rs.Set(l, m);
             }
         }
-        Rs.at(l) = l_m_paths;
     }
     
+    // vertices that update each SV
+    size_t num_SVs = 0;
+    for (size_t l=0; l<_numVertices; l++) {
+        for (size_t sv : _Is.at(l)) num_SVs = std::max(num_SVs, sv + 1);
+        for (size_t sv : _Os.at(l)) num_SVs = std::max(num_SVs, sv + 1);
+    }
+    OoO_BitMatrix SV_writers(num_SVs, _numVertices);
+    for (size_t l=0; l<_numVertices; l++) {
+        for (size_t sv : _Os.at(l)) {
+            SV_writers.Set(sv, l);
+        }
+    }
+    
+    const size_t num_words = Rs.getNumWords();
+    std::vector<uint64_t> U_Sk(num_words);
+    
     // later-event vertex
     for (size_t k=0; k<_numVertices; k++) {
-        // create vertex-k SV set Sk
-        std::vector<size_t> S_k;
-        S_k.reserve(_Is.at(k).size() + _Os.at(k).size());
-        std::set_union(_Is.at(k).begin(), _Is.at(k).end(),
-                      _Os.at(k).begin(), _Os.at(k).end(),
-                      std::back_inserter(S_k));
-        std::sort(S_k.begin(), S_k.end());
-        
-        // set of vertices that can update Sk
-        std::vector<size_t> U_Sk;
-        U_Sk.reserve(_numVertices);
-        for (size_t l=0; l<_numVertices; l++) {
-            std::vector<size_t> Ol_Sk;
-            Ol_Sk.reserve(std::min(_Os.at(l).size(), S_k.size()));
-            std::set_intersection(_Os.at(l).begin(), _Os.at(l).end(),
-                                S_k.begin(), S_k.end(),
-                                std::back_inserter(Ol_Sk));
-            if (Ol_Sk.size() > 0) {
-                U_Sk.push_back(l);
+        // set of vertices that can update Sk, the union of vertex k's input and output SVs
+        std::fill(U_Sk.begin(), U_Sk.end(), 0);
+        for (const std::vector<size_t>* S_k_part : {&_Is.at(k), &_Os.at(k)}) {
+            for (size_t sv : *S_k_part) {
+                const uint64_t* writers = SV_writers.Row(sv);
+                for (size_t w=0; w<num_words; w++) {
+                    U_Sk[w] |= writers[w];
+                }
             }
         }
-        std::sort(U_Sk.begin(), U_Sk.end());
       
         // earlier-event vertex
         for (size_t j=0; j<_numVertices; j++) {
-            // vertices reachable from vertex j and can update SVs in Sk
-            std::vector<size_t> X_jk;
-            X_jk.reserve(std::min(Rs.at(j).size(), U_Sk.size()));
-            std::set_intersection(Rs.at(j).begin(), Rs.at(j).end(),
-                                U_Sk.begin(), U_Sk.end(),
-                                std::back_inserter(X_jk));
-            
-            // shortest-path j-x times, set minimum to ITL j-k value
-            if (X_jk.size() > 0) {
-                std::vector<float> T_jx;  
-                T_jx.reserve(X_jk.size());
-                for (auto& x_jk : X_jk) {
-                    T_jx.push_back(shortest_paths.at(j).at(x_jk));
-                }
-                ITL.at(j).at(k) = *(std::min_element(T_jx.begin(), T_jx.end()));
-            }
-            // vertex j cannot affect vertex k
-            else {
-                ITL.at(j).at(k) = std::numeric_limits<float>::max();
-            }
+            // shortest-path j-x times over vertices x reachable from vertex j that can update SVs
+            // in Sk; the minimum is the ITL j-k value, or vertex j cannot affect vertex k
+            const float* j_paths = shortest_paths.Row(j);
+            float T_jx_min = std::numeric_limits<float>::max();
+            OoO_BitMatrix::ForEachCommon(Rs.Row(j), U_Sk.data(), num_words, [&](size_t x_jk) {
+                T_jx_min = std::min(T_jx_min, j_paths[x_jk]);
+            });
+            ITL(j, k) = T_jx_min;
         }
     }
     
@@ -136,90 +444,1016 @@ std::vector<std::vector<float>> OoO_SimModel::MakeITL(std::string tableFilename)
     auto ITL_table_p2_gen_start = std::chrono::high_resolution_clock::now();
     
     // ITL, Phase Two
-    // earlier event vertex
+    ITL_PhaseTwo(ITL, shortest_paths);
+    
+    auto ITL_table_p2_gen_stop = std::chrono::high_resolution_clock::now();
+    auto ITL_table_p2_gen_duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        ITL_table_p2_gen_stop - ITL_table_p2_gen_start);
+    printf("ITL table phase 2 generation time %lf seconds\n", 
+           ITL_table_p2_gen_duration.count() / 1e6);
+
+    return ITL;
+}
+
+std::vector<std::vector<size_t>> OoO_SimModel::SV_WriterSets() const
+{
+    size_t num_SVs = 0;
+    for (size_t l=0; l<_numVertices; l++) {
+        for (size_t sv : _Is.at(l)) num_SVs = std::max(num_SVs, sv + 1);
+        for (size_t sv : _Os.at(l)) num_SVs = std::max(num_SVs, sv + 1);
+    }
+    std::vector<std::vector<size_t>> SV_writers(num_SVs);
+    for (size_t l=0; l<_numVertices; l++) {
+        for (size_t sv : _Os.at(l)) SV_writers[sv].push_back(l);
+    }
+    std::vector<std::vector<size_t>> U_S(_numVertices);
+    for (size_t k=0; k<_numVertices; k++) {
+        for (const std::vector<size_t>* S_k_part : {&_Is.at(k), &_Os.at(k)}) {
+            for (size_t sv : *S_k_part) {
+                U_S[k].insert(U_S[k].end(), SV_writers[sv].begin(), SV_writers[sv].end());
+            }
+        }
+        std::sort(U_S[k].begin(), U_S[k].end());
+        U_S[k].erase(std::unique(U_S[k].begin(), U_S[k].end()), U_S[k].end());
+    }
+    return U_S;
+}
+
+bool OoO_SimModel::EdgeDelayClasses(std::vector<float>& classDelays) const
+{
+    // Every edge needs a class, and all edges of a class the same positive delay
+    classDelays.clear();
+    for (const auto& vertex_edges : _edges) {
+        for (const auto& edge : vertex_edges) {
+            int delay_class = edge.getDelayClass();
+            if (delay_class < 0 || static_cast<size_t>(delay_class) >= OoO_ParametricITL::_maxDelayClasses ||
+                !(edge.getMinDist() > 0)) {
+                return false;
+            }
+            if (static_cast<size_t>(delay_class) >= classDelays.size()) {
+                classDelays.resize(delay_class + 1, -1);
+            }
+            if (classDelays[delay_class] < 0) {
+                classDelays[delay_class] = edge.getMinDist();
+            } else if (classDelays[delay_class] != edge.getMinDist()) {
+                return false;
+            }
+        }
+    }
+    return !classDelays.empty();
+}
+
+OoO_ITLMatrix OoO_SimModel::EvaluateParametricITL(const std::vector<float>& classDelays) const
+{
+    uint64_t topology_fingerprint = ModelFingerprint(false);
+    std::string parametric_path = CachedTablePath(topology_fingerprint, ".pitl");
+    
+    OoO_ParametricITL parametric = OoO_ParametricITL::ReadFile(parametric_path, topology_fingerprint);
+    if (parametric.empty() || parametric.getNumClasses() != classDelays.size()) {
+        parametric = OoO_ParametricITL(_numVertices, classDelays.size());
+        if (!MakeParametricITL(parametric)) {
+            std::cerr << "Warning: too many candidate paths for a parametric ITL table" << std::endl;
+            return OoO_ITLMatrix();
+        }
+        if (!parametric.WriteFile(parametric_path, topology_fingerprint)) {
+            std::cerr << "Failed to write parametric ITL table " << parametric_path << "\n";
+        }
+    } else {
+        std::cout << "Data successfully read from " << parametric_path << "\n";
+    }
+    
+    auto ITL_table_eval_start = std::chrono::high_resolution_clock::now();
+    OoO_ITLMatrix ITL = parametric.Evaluate(classDelays);
+    auto ITL_table_eval_stop = std::chrono::high_resolution_clock::now();
+    auto ITL_table_eval_duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        ITL_table_eval_stop - ITL_table_eval_start);
+    printf("Parametric ITL table evaluation time %lf seconds\n", ITL_table_eval_duration.count() / 1e6);
+    return ITL;
+}
+
+bool OoO_SimModel::MakeParametricITL(OoO_ParametricITL& parametric) const
+{
+    typedef OoO_ParametricITL::PathForm PathForm;
+    typedef OoO_ParametricITL::Entry Entry;
+    auto ITL_table_gen_start = std::chrono::high_resolution_clock::now();
+    
+    // Candidate shortest paths from every source, breadth first by edge count: a path can only be
+    // beaten on every class by one with fewer edges, so no candidate is dropped once added
+    OoO_ParametricITL paths(_numVertices, parametric.getNumClasses());
+    bool overflow = false;
+    #pragma omp parallel
+    {
+        std::vector<std::pair<size_t, PathForm>> layer, next_layer;
+        #pragma omp for schedule(dynamic, 16) reduction(||:overflow)
+        for (size_t source=0; source<_numVertices; source++) {
+            PathForm empty_path = {};
+            paths(source, source).Add(empty_path);
+            layer.assign(1, std::make_pair(source, empty_path));
+            while (!layer.empty() && !overflow) {
+                next_layer.clear();
+                for (const auto& [vertex, form] : layer) {
+                    for (const auto& edge : _edges.at(vertex)) {
+                        size_t target = edge.getTermVertexIndex();
+                        if (vertex == target) continue;
+                        PathForm extended = form;
+                        uint16_t& count = extended.counts[edge.getDelayClass()];
+                        if (std::numeric_limits<uint16_t>::max() == count) {
+                            overflow = true;
+                            break;
+                        }
+                        count++;
+                        Entry& candidates = paths(source, target);
+                        if (candidates.Covers(extended)) continue;
+                        if (!candidates.Add(extended)) {
+                            overflow = true;
+                            break;
+                        }
+                        next_layer.emplace_back(target, extended);
+                    }
+                }
+                layer.swap(next_layer);
+            }
+        }
+    }
+    if (overflow) return false;
+    
+    const std::vector<std::vector<size_t>> U_S = SV_WriterSets();
+    
+    // Phase one: candidate paths from j to any vertex that can update Sk
+    #pragma omp parallel for schedule(static) reduction(||:overflow)
+    for (size_t j=0; j<_numVertices; j++) {
+        for (size_t k=0; k<_numVertices && !overflow; k++) {
+            for (size_t x : U_S[k]) {
+                if (!parametric(j, k).Add(paths(j, x))) {
+                    overflow = true;
+                    break;
+                }
+            }
+        }
+    }
+    if (overflow) return false;
+    
+    // Phase two over the closure of the zero limits, as in ITL_PhaseTwo. Delays are positive, so a
+    // path time is 0 only for the empty path whatever the delays: a zero limit i-l makes l-i zero, and
+    // the closure is the phase-one zeros together with their transpose, the same for every set.
+    OoO_BitMatrix Zs(_numVertices, _numVertices);
+    for (size_t i=0; i<_numVertices; i++) {
+        for (size_t l=0; l<_numVertices; l++) {
+            if (parametric(i, l).IsZero()) {
+                Zs.Set(i, l);
+                Zs.Set(l, i);
+            }
+        }
+    }
+    const size_t num_words = Zs.getNumWords();
     for (size_t h=0; h<_numVertices; h++) {
-        // later event vertex
         for (size_t i=0; i<_numVertices; i++) {
-            // vertices that vertex i can affect immediately
-            std::vector<size_t> Z_i;
-            Z_i.reserve(_numVertices);
-            for (size_t l=0; l<_numVertices; l++) {
-                // vertex i can affect vertex l immediately
-                if (0 == ITL.at(i).at(l)) {
-                    Z_i.push_back(l);
-                }
+            Entry T_hi = {};
+            OoO_BitMatrix::ForEachSet(Zs.Row(i), num_words, [&](size_t x_hi) {
+                overflow = overflow || !T_hi.Add(paths(h, x_hi));
+            });
+            overflow = overflow || !parametric(h, i).Add(T_hi);
+            if (overflow) return false;
+        }
+    }
+    
+    auto ITL_table_gen_stop = std::chrono::high_resolution_clock::now();
+    auto ITL_table_gen_duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        ITL_table_gen_stop - ITL_table_gen_start);
+    printf("Parametric ITL table generation time %lf seconds\n", ITL_table_gen_duration.count() / 1e6);
+    return true;
+}
+
+bool OoO_SimModel::MakeLatticeITL(const OoO_LatticeLayout& layout, std::vector<float>& offsetLimits) const
+{
+    auto ITL_table_gen_start = std::chrono::high_resolution_clock::now();
+    
+    const size_t num_types = layout.numTypes;
+    const size_t num_nodes = layout.NumNodes();
+    if (num_nodes * num_types != _numVertices) {
+        std::cerr << "Warning: lattice layout covers " << num_nodes * num_types << " vertices, model has "
+                  << _numVertices << "; using the ITL matrix" << std::endl;
+        return false;
+    }
+    
+    const std::vector<std::vector<size_t>> U_S = SV_WriterSets();
+    
+    // The limits depend only on the types and the node offset if the edges and SV writers are invariant
+    // under a unit step along each dimension, which generates every lattice translation
+    const Adjacency adjacency = BuildAdjacency();
+    size_t unit_step = 1;
+    for (size_t dim : layout.dims) {
+        std::vector<std::pair<size_t, float>> moved_edges, edges;
+        std::vector<size_t> moved_writers;
+        for (size_t v=0; v<_numVertices; v++) {
+            size_t moved_v = layout.Translate(v, unit_step);
+            moved_edges.clear();
+            edges.clear();
+            for (size_t a=adjacency.offsets[v]; a<adjacency.offsets[v + 1]; a++) {
+                moved_edges.emplace_back(layout.Translate(adjacency.targets[a], unit_step), adjacency.delays[a]);
+            }
+            for (size_t a=adjacency.offsets[moved_v]; a<adjacency.offsets[moved_v + 1]; a++) {
+                edges.emplace_back(adjacency.targets[a], adjacency.delays[a]);
             }
-            sort(Z_i.begin(), Z_i.end());
+            std::sort(moved_edges.begin(), moved_edges.end());
+            std::sort(edges.begin(), edges.end());
             
-            // vertices that vertex h can reach and that vertex i can affect immediately
-            std::vector<size_t> X_hi;
-            X_hi.reserve(std::min(Rs.at(h).size(), Z_i.size()));
-            std::set_intersection(Rs.at(h).begin(), Rs.at(h).end(),
-                                Z_i.begin(), Z_i.end(),
-                                std::back_inserter(X_hi));
-            std::sort(X_hi.begin(), X_hi.end());
+            moved_writers.clear();
+            for (size_t l : U_S[v]) moved_writers.push_back(layout.Translate(l, unit_step));
+            std::sort(moved_writers.begin(), moved_writers.end());
             
-            // if intersection vertices exist
-            if (X_hi.size() > 0) {
-                std::vector<float> T_hi;
-                T_hi.reserve(X_hi.size());
-                
-                // get shortest-path times for each intersection vertex
-                for (const auto& x_hi : X_hi) {
-                    T_hi.push_back(shortest_paths.at(h).at(x_hi));
+            if (moved_edges != edges || moved_writers != U_S[moved_v]) {
+                std::cerr << "Warning: model is not periodic on its lattice layout, using the ITL matrix" << std::endl;
+                return false;
+            }
+        }
+        unit_step *= dim;
+    }
+    
+    // Rows of the ITL table for the vertices of node 0, one per type; by translation they hold every limit
+    std::vector<std::vector<float>> paths(num_types, std::vector<float>(_numVertices, std::numeric_limits<float>::max()));
+    std::vector<std::vector<float>> phase_one(num_types, std::vector<float>(_numVertices));
+    std::vector<std::vector<size_t>> Z(num_types);
+    std::vector<QueueEntry> queue;
+    for (size_t t=0; t<num_types; t++) {
+        DijkstraFrom(t, adjacency, paths[t].data(), queue);
+        
+        // Phase one: shortest-path time to any vertex that can update Sk (unreachable ones are at FLT_MAX)
+        for (size_t k=0; k<_numVertices; k++) {
+            float T_tx_min = std::numeric_limits<float>::max();
+            for (size_t x : U_S[k]) T_tx_min = std::min(T_tx_min, paths[t][x]);
+            phase_one[t][k] = T_tx_min;
+            if (0 == T_tx_min) Z[t].push_back(k);
+        }
+    }
+    
+    // Phase two: the zero vertices of later vertex i are those of its type's node-0 vertex, moved to i's node.
+    // Zeros it creates are zero vertices too, so repeat until no new zeros appear, the closure
+    // ITL_PhaseTwo takes.
+    offsetLimits.assign(num_types * num_types * num_nodes, std::numeric_limits<float>::max());
+    bool new_zeros = true;
+    while (new_zeros) {
+        new_zeros = false;
+        for (size_t t=0; t<num_types; t++) {
+            for (size_t i=0; i<_numVertices; i++) {
+                size_t i_node = i / num_types;
+                size_t i_type = i % num_types;
+                float limit = phase_one[t][i];
+                for (size_t l : Z[i_type]) {
+                    limit = std::min(limit, paths[t][layout.Translate(l, i_node)]);
                 }
-                std::sort(T_hi.begin(), T_hi.end());
-                
-                // update ITL if phase-two value is smaller
-                if (T_hi.at(0) < ITL.at(h).at(i)) {
-                    ITL.at(h).at(i) = T_hi.at(0);
+                offsetLimits[(t * num_types + i_type) * num_nodes + i_node] = limit;
+                if (0 == limit && 0 < phase_one[t][i]) {
+                    phase_one[t][i] = 0;
+                    Z[t].push_back(i);
+                    new_zeros = true;
                 }
             }
         }
     }
     
-    auto ITL_table_p2_gen_stop = std::chrono::high_resolution_clock::now();
-    auto ITL_table_p2_gen_duration = std::chrono::duration_cast<std::chrono::microseconds>(
-        ITL_table_p2_gen_stop - ITL_table_p2_gen_start);
-    printf("ITL table phase 2 generation time %lf seconds\n", 
-           ITL_table_p2_gen_duration.count() / 1e6);
+    auto ITL_table_gen_stop = std::chrono::high_resolution_clock::now();
+    auto ITL_table_gen_duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        ITL_table_gen_stop - ITL_table_gen_start);
+    printf("Lattice ITL table generation time %lf seconds (%lu limits)\n",
+           ITL_table_gen_duration.count() / 1e6, offsetLimits.size());
+    return true;
+}
 
-    WriteITLTableToCSV(ITL, tableFilename);
-    return ITL;
+OoO_DependentPairs OoO_SimModel::MakeHorizonITL(float horizon) const
+{
+    auto ITL_table_gen_start = std::chrono::high_resolution_clock::now();
+    
+    const Adjacency adjacency = BuildAdjacency();
+    const std::vector<std::vector<size_t>> U_S = SV_WriterSets();
+    
+    // Later vertices whose SVs each vertex can update, the inverse of U_S
+    std::vector<std::vector<size_t>> updates(_numVertices);
+    for (size_t k=0; k<_numVertices; k++) {
+        for (size_t x : U_S[k]) updates[x].push_back(k);
+    }
+    
+    // Shortest paths below the horizon from every vertex
+    std::vector<std::vector<std::pair<size_t, float>>> paths(_numVertices);
+    #pragma omp parallel
+    {
+        std::vector<QueueEntry> queue;
+        std::vector<float> dist(_numVertices, std::numeric_limits<float>::max());
+        std::vector<size_t> reached;
+        #pragma omp for schedule(dynamic, 64)
+        for (size_t source=0; source<_numVertices; source++) {
+            DijkstraFrom(source, adjacency, dist.data(), queue, horizon, &reached);
+            paths[source].reserve(reached.size());
+            for (size_t x : reached) {
+                paths[source].emplace_back(x, dist[x]);
+                dist[x] = std::numeric_limits<float>::max();
+            }
+        }
+    }
+    
+    // Later vertices i that affect each vertex l immediately
+    const std::vector<std::vector<size_t>> zeros = ZeroLimits(adjacency, updates);
+    std::vector<std::vector<size_t>> zero_of(_numVertices);
+    for (size_t i=0; i<_numVertices; i++) {
+        for (size_t l : zeros[i]) zero_of[l].push_back(i);
+    }
+    
+    // Rows: limit h-i is the shortest time from h to a vertex that can update Si (phase one) or that
+    // i affects immediately (phase two); the paths below the horizon give every limit below it
+    std::vector<std::vector<std::pair<size_t, float>>> rows(_numVertices);
+    #pragma omp parallel
+    {
+        std::vector<float> limits(_numVertices, std::numeric_limits<float>::max());
+        std::vector<size_t> listed;
+        auto lower = [&](size_t i, float time) {
+            if (std::numeric_limits<float>::max() == limits[i]) listed.push_back(i);
+            limits[i] = std::min(limits[i], time);
+        };
+        #pragma omp for schedule(dynamic, 64)
+        for (size_t h=0; h<_numVertices; h++) {
+            listed.clear();
+            for (auto [x, time] : paths[h]) {
+                for (size_t k : updates[x]) lower(k, time);
+                for (size_t i : zero_of[x]) lower(i, time);
+            }
+            rows[h].reserve(listed.size());
+            for (size_t i : listed) {
+                rows[h].emplace_back(i, limits[i]);
+                limits[i] = std::numeric_limits<float>::max();
+            }
+        }
+    }
+    paths.clear();
+    
+    // Columns, each sorted by earlier-event vertex
+    std::vector<size_t> offsets(_numVertices + 1, 0);
+    for (const auto& row : rows) {
+        for (auto [i, limit] : row) offsets[i + 1]++;
+    }
+    for (size_t i=0; i<_numVertices; i++) offsets[i + 1] += offsets[i];
+    std::vector<int> vertex_indices(offsets.back());
+    std::vector<float> limits(offsets.back());
+    std::vector<size_t> next(offsets.begin(), offsets.end() - 1);
+    for (size_t h=0; h<_numVertices; h++) {
+        for (auto [i, limit] : rows[h]) {
+            vertex_indices[next[i]] = static_cast<int>(h);
+            limits[next[i]++] = limit;
+        }
+    }
+    
+    auto ITL_table_gen_stop = std::chrono::high_resolution_clock::now();
+    auto ITL_table_gen_duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        ITL_table_gen_stop - ITL_table_gen_start);
+    printf("Horizon ITL table generation time %lf seconds (%zu limits below horizon %g)\n",
+           ITL_table_gen_duration.count() / 1e6, limits.size(), horizon);
+    return OoO_DependentPairs(std::move(offsets), std::move(vertex_indices), std::move(limits));
 }
 
-std::vector<std::vector<float>> OoO_SimModel::ReadITLTableFromCSV(const std::string& tableFilename) const {
-    std::vector<std::vector<float>> ITL;
-    std::string directory = getExecutablePath() + "/ITL_tables/";
-    std::string filename = directory + tableFilename;
+std::vector<std::vector<size_t>> OoO_SimModel::ZeroLimits(const Adjacency& adjacency,
+                                                          const std::vector<std::vector<size_t>>& updates) const
+{
+    // Vertices each vertex reaches at zero time
+    std::vector<std::vector<size_t>> zero_paths(_numVertices);
+    #pragma omp parallel
+    {
+        std::vector<QueueEntry> queue;
+        std::vector<float> dist(_numVertices, std::numeric_limits<float>::max());
+        #pragma omp for schedule(dynamic, 64)
+        for (size_t source=0; source<_numVertices; source++) {
+            DijkstraFrom(source, adjacency, dist.data(), queue, std::numeric_limits<float>::denorm_min(), &zero_paths[source]);
+            for (size_t x : zero_paths[source]) dist[x] = std::numeric_limits<float>::max();
+        }
+    }
+    
+    // Phase-one zeros: j reaches a vertex that can update Sk at zero time. Then the closure of phase
+    // two over them, as in ComputeMaintainedZeros: a zero limit i-l makes h-i zero for every h
+    // reaching l at zero time.
+    std::vector<std::vector<size_t>> zeros(_numVertices);
+    std::vector<std::vector<size_t>> zero_paths_to(_numVertices);
+    for (size_t j=0; j<_numVertices; j++) {
+        for (size_t x : zero_paths[j]) {
+            zero_paths_to[x].push_back(j);
+            zeros[j].insert(zeros[j].end(), updates[x].begin(), updates[x].end());
+        }
+        std::sort(zeros[j].begin(), zeros[j].end());
+        zeros[j].erase(std::unique(zeros[j].begin(), zeros[j].end()), zeros[j].end());
+    }
+    std::unordered_set<uint64_t> is_zero;
+    std::vector<std::pair<size_t, size_t>> work;
+    for (size_t i=0; i<_numVertices; i++) {
+        for (size_t l : zeros[i]) {
+            is_zero.insert(static_cast<uint64_t>(i) * _numVertices + l);
+            work.emplace_back(i, l);
+        }
+    }
+    while (!work.empty()) {
+        auto [i, l] = work.back();
+        work.pop_back();
+        for (size_t h : zero_paths_to[l]) {
+            if (!is_zero.insert(static_cast<uint64_t>(h) * _numVertices + i).second) continue;
+            zeros[h].push_back(i);
+            work.emplace_back(h, i);
+        }
+    }
+    return zeros;
+}
+
+bool OoO_SimModel::MakeTiledITL(const std::string& tablePath, uint64_t fingerprint) const
+{
+    auto ITL_table_gen_start = std::chrono::high_resolution_clock::now();
+    
+    const Adjacency adjacency = BuildAdjacency();
+    const std::vector<std::vector<size_t>> U_S = SV_WriterSets();
+    std::vector<std::vector<size_t>> updates(_numVertices);
+    for (size_t k=0; k<_numVertices; k++) {
+        for (size_t x : U_S[k]) updates[x].push_back(k);
+    }
+    const std::vector<std::vector<size_t>> zeros = ZeroLimits(adjacency, updates);
+    
+    // Edges reversed, so one Dijkstra from a set of vertices gives every vertex's time to the nearest of them
+    Adjacency reversed;
+    reversed.offsets.assign(_numVertices + 1, 0);
+    for (size_t target : adjacency.targets) reversed.offsets[target + 1]++;
+    for (size_t v=0; v<_numVertices; v++) reversed.offsets[v + 1] += reversed.offsets[v];
+    reversed.targets.resize(adjacency.targets.size());
+    reversed.delays.resize(adjacency.delays.size());
+    std::vector<size_t> next(reversed.offsets.begin(), reversed.offsets.end() - 1);
+    for (size_t v=0; v<_numVertices; v++) {
+        for (size_t a=adjacency.offsets[v]; a<adjacency.offsets[v + 1]; a++) {
+            size_t r = next[adjacency.targets[a]]++;
+            reversed.targets[r] = v;
+            reversed.delays[r] = adjacency.delays[a];
+        }
+    }
+    
+    std::error_code error;
+    fs::create_directories(fs::path(tablePath).parent_path(), error);
+    OoO_TiledITL::Writer writer(tablePath, _numVertices, fingerprint);
+    
+    // Column i holds limit h-i for every h: the shortest time from h to a vertex that can update Si
+    // (phase one) or that i affects immediately (phase two). Only one block of columns is in memory.
+    std::vector<float> columns(OoO_TiledITL::_tileSize * _numVertices);
+    for (size_t block=0; block<writer.NumBlocks(); block++) {
+        const size_t block_begin = block * OoO_TiledITL::_tileSize;
+        const size_t block_size = std::min(OoO_TiledITL::_tileSize, _numVertices - block_begin);
+        std::fill(columns.begin(), columns.end(), std::numeric_limits<float>::max());
+        #pragma omp parallel
+        {
+            std::vector<QueueEntry> queue;
+            std::vector<size_t> sources;
+            #pragma omp for schedule(dynamic, 4)
+            for (size_t c=0; c<block_size; c++) {
+                size_t i = block_begin + c;
+                sources.assign(U_S[i].begin(), U_S[i].end());
+                sources.insert(sources.end(), zeros[i].begin(), zeros[i].end());
+                DijkstraFromSources(sources, reversed, &columns[c * _numVertices], queue);
+            }
+        }
+        if (!writer.WriteBlock(columns.data())) {
+            return false;
+        }
+    }
+    if (!writer.Close()) {
+        return false;
+    }
+    
+    auto ITL_table_gen_stop = std::chrono::high_resolution_clock::now();
+    auto ITL_table_gen_duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        ITL_table_gen_stop - ITL_table_gen_start);
+    printf("Tiled ITL table generation time %lf seconds (%zu x %zu tiles of %zu vertices)\n",
+           ITL_table_gen_duration.count() / 1e6, writer.NumBlocks(), writer.NumBlocks(), OoO_TiledITL::_tileSize);
+    return true;
+}
+
+float OoO_SimModel::ITL_Horizon() const
+{
+    if ("auto" != _options.ITLHorizon) {
+        const char* value = _options.ITLHorizon.c_str();
+        char* value_end = nullptr;
+        float horizon = std::strtof(value, &value_end);
+        if (value_end == value || '\0' != *value_end || !(horizon > 0)) {
+            std::cerr << "Error: ITL horizon '" << _options.ITLHorizon << "' is not off, auto or a positive time" << std::endl;
+            exit(1);
+        }
+        return horizon;
+    }
+    
+    std::ifstream range_file(CachedTablePath(ModelFingerprint(true), ".range"));
+    double recorded_range = 0;
+    if (range_file >> recorded_range && recorded_range > 0) {
+        printf("ITL horizon from the recorded event-set range %g\n", recorded_range);
+        return static_cast<float>(_horizonRangeMargin * recorded_range);
+    }
+    
+    float max_delay = 0;
+    for (const auto& vertex_edges : _edges) {
+        for (const auto& edge : vertex_edges) max_delay = std::max(max_delay, edge.getMinDist());
+    }
+    printf("ITL horizon from the largest edge delay %g, no event-set range recorded\n", max_delay);
+    return _horizonDefaultEdgeDelays * max_delay;
+}
 
-    // Open the file
-    std::ifstream file(filename);
+void OoO_SimModel::RecordE_RangeMax() const
+{
+    // Keep the largest range over all runs of the model
+    std::string range_path = CachedTablePath(ModelFingerprint(true), ".range");
+    double range = _simExec->GetE_RangesMaxRange();
+    std::ifstream recorded_file(range_path);
+    double recorded_range = 0;
+    if (recorded_file >> recorded_range && recorded_range >= range) return;
+    recorded_file.close();
+    
+    // Write to a private file and rename it into place, as concurrent runs may record too
+    std::error_code error;
+    fs::create_directories(fs::path(range_path).parent_path(), error);
+    std::string temp_path = range_path + ".tmp" + std::to_string(getpid());
+    std::ofstream range_file(temp_path);
+    range_file << std::setprecision(std::numeric_limits<double>::max_digits10) << range << std::endl;
+    range_file.close();
+    if (!range_file || 0 != std::rename(temp_path.c_str(), range_path.c_str())) {
+        std::remove(temp_path.c_str());
+        std::cerr << "Failed to record the event-set range in " << range_path << "\n";
+    }
+}
 
-    if (!file.is_open()) {
-        std::cerr << "Failed to open file for reading.\n";
-        return ITL;
+void OoO_SimModel::ITL_PhaseTwo(OoO_ITLMatrix& ITL, const OoO_ITLMatrix& shortestPaths) const
+{
+    // Phase two lowers ITL h-i to the shortest-path time from h to any vertex l that vertex i affects
+    // immediately (ITL i-l == 0): a min-plus product of the shortest paths with the zero-ITL mask.
+    // Unreachable vertices are at FLT_MAX, which never lowers a value, so reachability needs no mask.
+    std::vector<std::vector<size_t>> zeros(_numVertices);
+    OoO_BitMatrix is_zero(_numVertices, _numVertices);
+    for (size_t i=0; i<_numVertices; i++) {
+        const float* ITL_i = ITL.Row(i);
+        for (size_t l=0; l<_numVertices; l++) {
+            if (0 == ITL_i[l]) {
+                zeros[i].push_back(l);
+                is_zero.Set(i, l);
+            }
+        }
+    }
+    
+    // Row i of the result holds the phase-two times from every h to later vertex i, the minimum of
+    // the shortest-path columns of i's zero vertices; tiled over h so the output block stays in L1.
+    // A time of 0 makes i a zero vertex of h, so the rows whose zero vertices grew fold in the new
+    // ones, until none appear: the closure of ComputeMaintainedZeros and ZeroLimits.
+    OoO_ITLMatrix paths_to = shortestPaths.Transposed();
+    OoO_ITLMatrix phase_two_to(_numVertices, std::numeric_limits<float>::max());
+    std::vector<size_t> num_folded(_numVertices, 0);    // Zero vertices of each row already folded in
+    std::vector<size_t> rows(_numVertices);
+    std::iota(rows.begin(), rows.end(), 0);
+    std::vector<size_t> grown_rows;
+    while (!rows.empty()) {
+        #pragma omp parallel for schedule(dynamic)
+        for (size_t r=0; r<rows.size(); r++) {
+            const size_t i = rows[r];
+            float* T_i = phase_two_to.Row(i);
+            for (size_t h_begin=0; h_begin<_numVertices; h_begin+=_minPlusTileSize) {
+                const size_t h_end = std::min(h_begin + _minPlusTileSize, _numVertices);
+                for (size_t z=num_folded[i]; z<zeros[i].size(); z++) {
+                    const float* paths_to_l = paths_to.Row(zeros[i][z]);
+                    #pragma omp simd
+                    for (size_t h=h_begin; h<h_end; h++) {
+                        T_i[h] = (paths_to_l[h] < T_i[h]) ? paths_to_l[h] : T_i[h];
+                    }
+                }
+            }
+        }
+        for (size_t i : rows) {
+            num_folded[i] = zeros[i].size();
+        }
+        
+        // New zeros can only come from the rows just folded
+        grown_rows.clear();
+        for (size_t i : rows) {
+            const float* T_i = phase_two_to.Row(i);
+            for (size_t h=0; h<_numVertices; h++) {
+                if (0 == T_i[h] && !is_zero.Test(h, i)) {
+                    is_zero.Set(h, i);
+                    if (zeros[h].size() == num_folded[h]) grown_rows.push_back(h);
+                    zeros[h].push_back(i);
+                }
+            }
+        }
+        rows.swap(grown_rows);
+    }
+    
+    for (size_t h=0; h<_numVertices; h++) {
+        float* ITL_h = ITL.Row(h);
+        for (size_t i=0; i<_numVertices; i++) {
+            if (phase_two_to(i, h) < ITL_h[i]) {
+                ITL_h[i] = phase_two_to(i, h);
+            }
+        }
     }
+}
+
+void OoO_SimModel::AddEdge(size_t origVertexIndex, size_t termVertexIndex, float minDist, int delayClass)
+{
+    QueueTopologyChange({TopologyChange::EdgeAdded, origVertexIndex, termVertexIndex, minDist, delayClass});
+}
 
-    // Read the 2D vector from the file
-    std::string line;
-    while (getline(file, line)) {
-        std::vector<float> row;
-        std::stringstream ss(line);
-        std::string cell;
+void OoO_SimModel::RemoveEdge(size_t origVertexIndex, size_t termVertexIndex)
+{
+    QueueTopologyChange({TopologyChange::EdgeRemoved, origVertexIndex, termVertexIndex, 0, Edge::_noDelayClass});
+}
 
-        while (getline(ss, cell, ',')) {
-            row.push_back(static_cast<float>(std::stoi(cell)));
+void OoO_SimModel::AddSV_Dependency(size_t vertexIndex, size_t SV_Index, bool isOutput)
+{
+    TopologyChange::Kind kind = isOutput ? TopologyChange::OutputAdded : TopologyChange::InputAdded;
+    QueueTopologyChange({kind, vertexIndex, SV_Index, 0, Edge::_noDelayClass});
+}
+
+void OoO_SimModel::RemoveSV_Dependency(size_t vertexIndex, size_t SV_Index, bool isOutput)
+{
+    TopologyChange::Kind kind = isOutput ? TopologyChange::OutputRemoved : TopologyChange::InputRemoved;
+    QueueTopologyChange({kind, vertexIndex, SV_Index, 0, Edge::_noDelayClass});
+}
+
+void OoO_SimModel::QueueTopologyChange(const TopologyChange& change)
+{
+    if (change.vertexIndex >= _numVertices ||
+        (change.kind <= TopologyChange::EdgeRemoved && change.other >= _numVertices)) {
+        std::cerr << "Error: topology change refers to a vertex outside the model" << std::endl;
+        exit(1);
+    }
+    std::lock_guard<std::mutex> lock(_topologyMutex);
+    _pendingChanges.push_back(change);
+}
+
+void OoO_SimModel::ApplyTopologyChange(const TopologyChange& change)
+{
+    std::vector<size_t>* SVs = nullptr;
+    switch (change.kind) {
+        case TopologyChange::EdgeAdded:
+            _edges.at(change.vertexIndex).emplace_back(change.vertexIndex, change.other, change.minDist, change.delayClass);
+            return;
+        case TopologyChange::EdgeRemoved: {
+            // Edges are not assignable, so rebuild the vertex's list without the removed ones
+            std::vector<Edge> kept_edges;
+            for (const auto& edge : _edges.at(change.vertexIndex)) {
+                if (edge.getTermVertexIndex() != change.other) kept_edges.push_back(edge);
+            }
+            _edges.at(change.vertexIndex).swap(kept_edges);
+            return;
         }
-        ITL.push_back(row);
+        case TopologyChange::InputAdded:
+        case TopologyChange::InputRemoved:
+            SVs = &_Is.at(change.vertexIndex);
+            break;
+        case TopologyChange::OutputAdded:
+        case TopologyChange::OutputRemoved:
+            SVs = &_Os.at(change.vertexIndex);
+            break;
     }
-    file.close();
-    std::cout << "Data successfully read from " << filename << "\n";
+    auto existing = std::find(SVs->begin(), SVs->end(), change.other);
+    bool adding = (TopologyChange::InputAdded == change.kind || TopologyChange::OutputAdded == change.kind);
+    if (adding && existing == SVs->end()) SVs->push_back(change.other);
+    if (!adding && existing != SVs->end()) SVs->erase(existing);
+}
 
-    return ITL;
+void OoO_SimModel::PublishITL()
+{
+    // The maintained table is dense; rebuilding a lattice, tiled or horizon provider from it would
+    // defeat the reason the run chose one
+    if ("matrix" != _ITLProviderKind) {
+        std::cerr << "Error: PublishITL needs a dense ITL table, but this run uses the " << _ITLProviderKind
+                  << " provider (set itl_provider to matrix and itl_horizon to off)" << std::endl;
+        exit(1);
+    }
+    std::lock_guard<std::mutex> lock(_topologyMutex);
+    auto ITL_update_start = std::chrono::high_resolution_clock::now();
+    size_t num_changes = MaintainITL();
+
+    // The event set takes ownership of its table, so it gets a copy of the maintained one
+    OoO_ITLMatrix ITL(_numVertices, 0);
+    for (size_t j=0; j<_numVertices; j++) {
+        std::copy(_maintainedITL.Row(j), _maintainedITL.Row(j) + _numVertices, ITL.Row(j));
+    }
+    _simExec->PublishITL(DenseITLProvider(std::move(ITL)));
+
+    auto ITL_update_stop = std::chrono::high_resolution_clock::now();
+    auto ITL_update_duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        ITL_update_stop - ITL_update_start);
+    printf("ITL table update time %lf seconds (%zu changes)\n", ITL_update_duration.count() / 1e6, num_changes);
+}
+
+size_t OoO_SimModel::MaintainITL()
+{
+    std::vector<TopologyChange> changes;
+    changes.swap(_pendingChanges);
+    if (_maintainedITL.empty()) {
+        for (const TopologyChange& change : changes) ApplyTopologyChange(change);
+        InitMaintainedITL();
+    } else {
+        UpdateMaintainedITL(changes);
+    }
+    return changes.size();
 }
 
-void OoO_SimModel::WriteITLTableToCSV(std::vector<std::vector<float>>& ITL, std::string tableFilename) const
+void OoO_SimModel::CheckMaintainedITL(size_t numChanges)
+{
+    auto update_and_compare = [this](const std::string& stage) {
+        size_t num_changes;
+        {
+            std::lock_guard<std::mutex> lock(_topologyMutex);
+            num_changes = MaintainITL();
+        }
+        OoO_ITLMatrix ITL = MakeITL();
+        size_t num_mismatches = 0;
+        for (size_t h=0; h<_numVertices; h++) {
+            for (size_t i=0; i<_numVertices; i++) {
+                if (ITL(h, i) == _maintainedITL(h, i)) continue;
+                if (0 == num_mismatches) {
+                    std::cerr << "Error: maintained ITL " << h << "-" << i << " is " << _maintainedITL(h, i)
+                              << ", MakeITL gives " << ITL(h, i) << std::endl;
+                }
+                num_mismatches++;
+            }
+        }
+        if (num_mismatches > 0) {
+            std::cerr << "Error: maintained ITL table differs from MakeITL in " << num_mismatches
+                      << " limits after " << stage << std::endl;
+            exit(1);
+        }
+        printf("Maintained ITL table matches MakeITL after %s (%zu changes)\n", stage.c_str(), num_changes);
+    };
+    update_and_compare("the initial build");
+
+    std::mt19937_64 rng(_distSeed);
+    std::vector<TopologyChange> undo;
+    for (size_t round=0; round<_ITL_CheckRounds; round++) {
+        if (!QueueRandomTopologyChanges(numChanges, false, rng, undo)) {
+            std::cout << "Model has no edges or SVs to change, nothing to check" << std::endl;
+            return;
+        }
+        update_and_compare("round " + std::to_string(round + 1));
+
+        for (const TopologyChange& change : undo) QueueTopologyChange(change);
+        update_and_compare("undoing round " + std::to_string(round + 1));
+    }
+}
+
+void OoO_SimModel::PublishLiveTopologyChanges(const std::atomic<bool>& simDone)
+{
+    // Added edges and SV dependencies can only lower ITL limits, and undoing them restores the model's
+    // own limits, so every table published here is safe and the run must produce the in-order trace
+    std::mt19937_64 rng(_distSeed);
+    std::vector<TopologyChange> undo;
+    PublishITL();
+    size_t num_published = 1;
+    while (!simDone.load(std::memory_order_acquire)) {
+        if (!QueueRandomTopologyChanges(_options.ITLLiveChanges, true, rng, undo)) break;
+        PublishITL();
+        std::this_thread::sleep_for(std::chrono::milliseconds(_liveChangesPeriodMs));
+        for (const TopologyChange& change : undo) QueueTopologyChange(change);
+        PublishITL();
+        std::this_thread::sleep_for(std::chrono::milliseconds(_liveChangesPeriodMs));
+        num_published += 2;
+    }
+    printf("ITL tables published during the run: %zu\n", num_published);
+}
+
+bool OoO_SimModel::QueueRandomTopologyChanges(size_t numChanges, bool additionsOnly, std::mt19937_64& rng,
+                                              std::vector<TopologyChange>& undo)
+{
+    size_t num_SVs = 0;
+    std::vector<Edge> model_edges;
+    for (size_t v=0; v<_numVertices; v++) {
+        for (const auto& edge : _edges[v]) model_edges.push_back(edge);
+        for (size_t sv : _Is[v]) num_SVs = std::max(num_SVs, sv + 1);
+        for (size_t sv : _Os[v]) num_SVs = std::max(num_SVs, sv + 1);
+    }
+    if (model_edges.empty() || 0 == num_SVs) return false;
+
+    // Each change touches an edge or SV no other change touches, so the undo list can be queued in any
+    // order. Added edges copy the delay and class of a model edge.
+    auto pick = [&rng](size_t n) { return std::uniform_int_distribution<size_t>(0, n - 1)(rng); };
+    std::set<std::pair<size_t, size_t>> touched_edges;
+    std::set<std::tuple<size_t, size_t, bool>> touched_SVs;
+    undo.clear();
+    for (size_t attempt=0; attempt<8*numChanges && touched_edges.size() + touched_SVs.size() < numChanges; attempt++) {
+        const size_t v = pick(_numVertices);
+        switch (pick(4)) {
+            case 0: {
+                if (additionsOnly || _edges[v].empty()) break;
+                const size_t term = _edges[v][pick(_edges[v].size())].getTermVertexIndex();
+                if (!touched_edges.emplace(v, term).second) break;
+                for (const auto& edge : _edges[v]) {
+                    if (edge.getTermVertexIndex() != term) continue;
+                    undo.push_back({TopologyChange::EdgeAdded, v, term, edge.getMinDist(), edge.getDelayClass()});
+                }
+                RemoveEdge(v, term);
+                break;
+            }
+            case 1: {
+                const size_t term = pick(_numVertices);
+                bool exists = (v == term);
+                for (const auto& edge : _edges[v]) exists = exists || edge.getTermVertexIndex() == term;
+                if (exists || !touched_edges.emplace(v, term).second) break;
+                const Edge& like = model_edges[pick(model_edges.size())];
+                undo.push_back({TopologyChange::EdgeRemoved, v, term, 0, Edge::_noDelayClass});
+                AddEdge(v, term, like.getMinDist(), like.getDelayClass());
+                break;
+            }
+            default: {
+                const bool is_output = (0 == pick(2));
+                const std::vector<size_t>& SVs = is_output ? _Os[v] : _Is[v];
+                const size_t sv = pick(num_SVs);
+                const bool adding = (std::find(SVs.begin(), SVs.end(), sv) == SVs.end());
+                if ((additionsOnly && !adding) || !touched_SVs.emplace(v, sv, is_output).second) break;
+                TopologyChange::Kind undo_kind = is_output ? (adding ? TopologyChange::OutputRemoved : TopologyChange::OutputAdded)
+                                                           : (adding ? TopologyChange::InputRemoved : TopologyChange::InputAdded);
+                undo.push_back({undo_kind, v, sv, 0, Edge::_noDelayClass});
+                if (adding) AddSV_Dependency(v, sv, is_output);
+                else RemoveSV_Dependency(v, sv, is_output);
+                break;
+            }
+        }
+    }
+    return true;
+}
+
+void OoO_SimModel::InitMaintainedITL()
+{
+    _maintainedPaths = DijkstraAllPairs();
+    _maintainedWriters = SV_WriterSets();
+
+    _maintainedPhaseOne = OoO_ITLMatrix(_numVertices, 0);
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (size_t j=0; j<_numVertices; j++) {
+        for (size_t k=0; k<_numVertices; k++) {
+            _maintainedPhaseOne(j, k) = MaintainedPhaseOne(j, k);
+        }
+    }
+
+    ComputeMaintainedZeros(_maintainedZeros);
+
+    _maintainedITL = OoO_ITLMatrix(_numVertices, 0);
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (size_t h=0; h<_numVertices; h++) {
+        for (size_t i=0; i<_numVertices; i++) {
+            _maintainedITL(h, i) = MaintainedLimit(h, i);
+        }
+    }
+}
+
+void OoO_SimModel::UpdateMaintainedITL(const std::vector<TopologyChange>& changes)
+{
+    // Sources whose shortest paths may change, judged against the paths before the change: an added
+    // edge u-v matters to sources it gives a shorter way to v, a removed one to sources whose shortest
+    // path to v may run through it
+    std::vector<char> affected_source(_numVertices, 0);
+    for (const TopologyChange& change : changes) {
+        const size_t u = change.vertexIndex;
+        const size_t v = change.other;
+        if (TopologyChange::EdgeAdded == change.kind && u != v) {
+            for (size_t a=0; a<_numVertices; a++) {
+                float a_u = _maintainedPaths(a, u);
+                if (a_u < std::numeric_limits<float>::max() && a_u + change.minDist < _maintainedPaths(a, v)) {
+                    affected_source[a] = 1;
+                }
+            }
+        } else if (TopologyChange::EdgeRemoved == change.kind && u != v) {
+            for (const auto& edge : _edges.at(u)) {
+                if (edge.getTermVertexIndex() != v) continue;
+                for (size_t a=0; a<_numVertices; a++) {
+                    float a_u = _maintainedPaths(a, u);
+                    if (a_u < std::numeric_limits<float>::max() && a_u + edge.getMinDist() <= _maintainedPaths(a, v)) {
+                        affected_source[a] = 1;
+                    }
+                }
+            }
+        }
+        ApplyTopologyChange(change);
+    }
+
+    // Rerun Dijkstra from the affected sources; rows that come out the same need no further work
+    const Adjacency adjacency = BuildAdjacency();
+    std::vector<char> changed_row(_numVertices, 0);
+    #pragma omp parallel
+    {
+        std::vector<QueueEntry> queue;
+        std::vector<float> dist(_numVertices);
+        #pragma omp for schedule(dynamic, 16)
+        for (size_t a=0; a<_numVertices; a++) {
+            if (!affected_source[a]) continue;
+            std::fill(dist.begin(), dist.end(), std::numeric_limits<float>::max());
+            DijkstraFrom(a, adjacency, dist.data(), queue);
+            float* a_paths = _maintainedPaths.Row(a);
+            if (!std::equal(dist.begin(), dist.end(), a_paths)) {
+                std::copy(dist.begin(), dist.end(), a_paths);
+                changed_row[a] = 1;
+            }
+        }
+    }
+
+    // Columns whose SV writer sets changed
+    std::vector<std::vector<size_t>> writers = SV_WriterSets();
+    std::vector<size_t> changed_cols;
+    for (size_t k=0; k<_numVertices; k++) {
+        if (writers[k] != _maintainedWriters[k]) changed_cols.push_back(k);
+    }
+    _maintainedWriters.swap(writers);
+
+    // Phase one depends on row j's paths and column k's writers
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (size_t j=0; j<_numVertices; j++) {
+        if (changed_row[j]) {
+            for (size_t k=0; k<_numVertices; k++) _maintainedPhaseOne(j, k) = MaintainedPhaseOne(j, k);
+        } else {
+            for (size_t k : changed_cols) _maintainedPhaseOne(j, k) = MaintainedPhaseOne(j, k);
+        }
+    }
+
+    // Zero sets, then the final limits of the changed rows and of the columns whose phase-one values
+    // or zero sets changed
+    std::vector<std::vector<size_t>> zeros;
+    ComputeMaintainedZeros(zeros);
+    std::vector<char> changed_col(_numVertices, 0);
+    for (size_t k : changed_cols) changed_col[k] = 1;
+    for (size_t i=0; i<_numVertices; i++) {
+        if (zeros[i] != _maintainedZeros[i]) changed_col[i] = 1;
+    }
+    _maintainedZeros.swap(zeros);
+    changed_cols.clear();
+    for (size_t i=0; i<_numVertices; i++) {
+        if (changed_col[i]) changed_cols.push_back(i);
+    }
+
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (size_t h=0; h<_numVertices; h++) {
+        if (changed_row[h]) {
+            for (size_t i=0; i<_numVertices; i++) _maintainedITL(h, i) = MaintainedLimit(h, i);
+        } else {
+            for (size_t i : changed_cols) _maintainedITL(h, i) = MaintainedLimit(h, i);
+        }
+    }
+}
+
+float OoO_SimModel::MaintainedPhaseOne(size_t j, size_t k) const
+{
+    // Shortest path from j to a vertex that can update the SVs of k (unreachable ones are FLT_MAX)
+    const float* j_paths = _maintainedPaths.Row(j);
+    float T_jx_min = std::numeric_limits<float>::max();
+    for (size_t x : _maintainedWriters[k]) {
+        T_jx_min = std::min(T_jx_min, j_paths[x]);
+    }
+    return T_jx_min;
+}
+
+void OoO_SimModel::ComputeMaintainedZeros(std::vector<std::vector<size_t>>& zeros) const
+{
+    // Vertices h that reach each vertex l at zero time
+    std::vector<std::vector<size_t>> zero_paths_to(_numVertices);
+    for (size_t h=0; h<_numVertices; h++) {
+        const float* h_paths = _maintainedPaths.Row(h);
+        for (size_t l=0; l<_numVertices; l++) {
+            if (0 == h_paths[l]) zero_paths_to[l].push_back(h);
+        }
+    }
+
+    // Start from the phase-one zeros; a zero limit i-l makes h-i zero for every h reaching l at zero time
+    OoO_BitMatrix is_zero(_numVertices, _numVertices);
+    zeros.assign(_numVertices, std::vector<size_t>());
+    std::vector<std::pair<size_t, size_t>> work;
+    for (size_t i=0; i<_numVertices; i++) {
+        const float* i_limits = _maintainedPhaseOne.Row(i);
+        for (size_t l=0; l<_numVertices; l++) {
+            if (0 == i_limits[l]) {
+                is_zero.Set(i, l);
+                zeros[i].push_back(l);
+                work.emplace_back(i, l);
+            }
+        }
+    }
+    while (!work.empty()) {
+        auto [i, l] = work.back();
+        work.pop_back();
+        for (size_t h : zero_paths_to[l]) {
+            if (is_zero.Test(h, i)) continue;
+            is_zero.Set(h, i);
+            zeros[h].push_back(i);
+            work.emplace_back(h, i);
+        }
+    }
+    for (auto& i_zeros : zeros) {
+        std::sort(i_zeros.begin(), i_zeros.end());
+    }
+}
+
+float OoO_SimModel::MaintainedLimit(size_t h, size_t i) const
+{
+    // Phase two: h-i is no later than the time for h to reach any vertex l that i affects immediately
+    const float* h_paths = _maintainedPaths.Row(h);
+    float limit = _maintainedPhaseOne(h, i);
+    for (size_t l : _maintainedZeros[i]) {
+        limit = std::min(limit, h_paths[l]);
+    }
+    return limit;
+}
+
+void OoO_SimModel::WriteITLTableToCSV(const OoO_ITLMatrix& ITL, std::string tableFilename) const
 {
     std::string directory = getExecutablePath() + "/ITL_tables/";
     std::string filename = directory + tableFilename;
@@ -232,11 +1466,12 @@ void OoO_SimModel::WriteITLTableToCSV(std::vector<std::vector<float>>& ITL, std:
         return;
     }
     
-    // Write the 2D vector to the file
-    for (const auto& row : ITL) {
-        for (size_t i = 0; i < row.size(); ++i) {
+    // Write the matrix to the file
+    for (size_t j = 0; j < ITL.size(); ++j) {
+        const float* row = ITL.Row(j);
+        for (size_t i = 0; i < ITL.size(); ++i) {
             file << row[i];
-            if (i != row.size() - 1) {
+            if (i != ITL.size() - 1) {
                 file << ","; // CSV format
             }
         }
@@ -246,15 +1481,133 @@ void OoO_SimModel::WriteITLTableToCSV(std::vector<std::vector<float>>& ITL, std:
     std::cout << "Data successfully written to " << filename << "\n";
 }
 
-std::vector<std::vector<float>> OoO_SimModel::FloydWarshall()
+OoO_ITLMatrix OoO_SimModel::ShortestPaths()
+{
+    size_t num_edges = 0;
+    for (const auto& vertex_edges : _edges) {
+        num_edges += vertex_edges.size();
+    }
+
+    // Dijkstra from every source costs about V*E*log(V), Floyd-Warshall V^3
+    double log_vertices = std::log2(static_cast<double>(std::max<size_t>(_numVertices, 2)));
+    if (static_cast<double>(num_edges) * log_vertices < static_cast<double>(_numVertices) * _numVertices) {
+        return DijkstraAllPairs();
+    }
+    return FloydWarshall();
+}
+
+OoO_SimModel::Adjacency OoO_SimModel::BuildAdjacency() const
+{
+    // Compressed adjacency lists, skipping self-loops; parallel edges keep their smallest delay
+    Adjacency adjacency;
+    adjacency.offsets.assign(_numVertices + 1, 0);
+    for (size_t i=0; i<_numVertices; i++) {
+        for (const auto& edge : _edges.at(i)) {
+            size_t targetVertexIdx = edge.getTermVertexIndex();
+            if (i == targetVertexIdx) continue;
+            auto first = adjacency.targets.begin() + adjacency.offsets[i];
+            auto existing = std::find(first, adjacency.targets.end(), targetVertexIdx);
+            if (existing != adjacency.targets.end()) {
+                float& delay = adjacency.delays[existing - adjacency.targets.begin()];
+                delay = std::min(delay, edge.getMinDist());
+            } else {
+                adjacency.targets.push_back(targetVertexIdx);
+                adjacency.delays.push_back(edge.getMinDist());
+            }
+        }
+        adjacency.offsets[i + 1] = adjacency.targets.size();
+    }
+    return adjacency;
+}
+
+void OoO_SimModel::DijkstraFrom(size_t source, const Adjacency& adjacency, float* dist, std::vector<QueueEntry>& queue,
+                                float horizon, std::vector<size_t>* reached)
+{
+    // Min-heap of (distance, vertex); dist must start at FLT_MAX
+    const std::greater<QueueEntry> later;
+    dist[source] = 0;
+    if (nullptr != reached) reached->assign(1, source);
+    queue.assign(1, QueueEntry(0.0f, source));
+    while (!queue.empty()) {
+        std::pop_heap(queue.begin(), queue.end(), later);
+        auto [source_dist, vertex] = queue.back();
+        queue.pop_back();
+        if (source_dist > dist[vertex]) continue;  // Stale entry
+        for (size_t a=adjacency.offsets[vertex]; a<adjacency.offsets[vertex + 1]; a++) {
+            float new_dist = source_dist + adjacency.delays[a];
+            if (new_dist < dist[adjacency.targets[a]] && new_dist < horizon) {
+                if (nullptr != reached && std::numeric_limits<float>::max() == dist[adjacency.targets[a]]) {
+                    reached->push_back(adjacency.targets[a]);
+                }
+                dist[adjacency.targets[a]] = new_dist;
+                queue.emplace_back(new_dist, adjacency.targets[a]);
+                std::push_heap(queue.begin(), queue.end(), later);
+            }
+        }
+    }
+}
+
+void OoO_SimModel::DijkstraFromSources(const std::vector<size_t>& sources, const Adjacency& adjacency, float* dist,
+                                       std::vector<QueueEntry>& queue)
+{
+    // As DijkstraFrom, with every source at time 0
+    const std::greater<QueueEntry> later;
+    queue.clear();
+    for (size_t source : sources) {
+        if (0 == dist[source]) continue;
+        dist[source] = 0;
+        queue.emplace_back(0.0f, source);
+    }
+    while (!queue.empty()) {
+        std::pop_heap(queue.begin(), queue.end(), later);
+        auto [source_dist, vertex] = queue.back();
+        queue.pop_back();
+        if (source_dist > dist[vertex]) continue;  // Stale entry
+        for (size_t a=adjacency.offsets[vertex]; a<adjacency.offsets[vertex + 1]; a++) {
+            float new_dist = source_dist + adjacency.delays[a];
+            if (new_dist < dist[adjacency.targets[a]]) {
+                dist[adjacency.targets[a]] = new_dist;
+                queue.emplace_back(new_dist, adjacency.targets[a]);
+                std::push_heap(queue.begin(), queue.end(), later);
+            }
+        }
+    }
+}
+
+OoO_ITLMatrix OoO_SimModel::DijkstraAllPairs()
+{
+    auto Dijkstra_table_gen_start = std::chrono::high_resolution_clock::now();
+    
+    const Adjacency adjacency = BuildAdjacency();
+    OoO_ITLMatrix dist(_numVertices, std::numeric_limits<float>::max());
+    
+    // Each source fills its own row
+    #pragma omp parallel
+    {
+        // Heap storage, reused across this thread's sources
+        std::vector<QueueEntry> queue;
+        #pragma omp for schedule(dynamic, 16)
+        for (size_t source=0; source<_numVertices; source++) {
+            DijkstraFrom(source, adjacency, dist.Row(source), queue);
+        }
+    }
+    
+    auto Dijkstra_table_gen_stop = std::chrono::high_resolution_clock::now();
+    auto Dijkstra_table_gen_duration = std::chrono::duration_cast<std::chrono::microseconds>(
+        Dijkstra_table_gen_stop - Dijkstra_table_gen_start);
+    printf("Dijkstra table generation time %lf seconds\n", Dijkstra_table_gen_duration.count() / 1e6);
+
+    return dist;
+}
+
+OoO_ITLMatrix OoO_SimModel::FloydWarshall()
 {
     auto FW_table_gen_start = std::chrono::high_resolution_clock::now();
     
     // Step 1: Initialize the distance matrix
-    std::vector<std::vector<float>> dist(_numVertices, 
-                                       std::vector<float>(_numVertices, std::numeric_limits<float>::max()));
+    OoO_ITLMatrix dist(_numVertices, std::numeric_limits<float>::max());
     for (size_t i=0; i<_numVertices; i++) {
-        dist[i][i] = 0;
+        dist(i, i) = 0;
     }
     
     // Step 2: Populate initial distances based on edges
@@ -264,22 +1617,58 @@ std::vector<std::vector<float>> OoO_SimModel::FloydWarshall()
             size_t targetVertexIdx = edge.getTermVertexIndex();
             float minDelayTime = edge.getMinDist();
             if (sourceVertexIdx != targetVertexIdx) { // Skip self-loops
-                dist[sourceVertexIdx][targetVertexIdx] = minDelayTime;
+                dist(sourceVertexIdx, targetVertexIdx) = minDelayTime;
             }
         }
     }
     
-    // Step 3: Apply Floyd-Warshall algorithm
-    for (size_t k=0; k<_numVertices; k++) {
-        for (size_t i=0; i<_numVertices; i++) {
-            for (size_t j=0; j<_numVertices; j++) {
-                if (dist[i][k] != std::numeric_limits<float>::max() && 
-                    dist[k][j] != std::numeric_limits<float>::max() &&
-                    dist[i][k] + dist[k][j] < dist[i][j]) {
-                    dist[i][j] = dist[i][k] + dist[k][j];
+    // Step 3: Apply Floyd-Warshall algorithm, blocked into tiles. For each diagonal tile, relax the
+    // tile itself, then its row and column of tiles, then all remaining tiles in parallel.
+    // Unreachable distances are FLT_MAX, whose sums never win the min, so no reachability checks.
+    auto relax_tile = [&dist](size_t i_begin, size_t i_end, size_t j_begin, size_t j_end, size_t k_begin, size_t k_end) {
+        for (size_t k=k_begin; k<k_end; k++) {
+            const float* dist_k = dist.Row(k);
+            for (size_t i=i_begin; i<i_end; i++) {
+                float* dist_i = dist.Row(i);
+                const float dist_ik = dist_i[k];
+                #pragma omp simd
+                for (size_t j=j_begin; j<j_end; j++) {
+                    const float dist_ikj = dist_ik + dist_k[j];
+                    dist_i[j] = (dist_ikj < dist_i[j]) ? dist_ikj : dist_i[j];
                 }
             }
         }
+    };
+    const size_t tile = _FW_TileSize;
+    const size_t num_tiles = (_numVertices + tile - 1) / tile;
+    for (size_t kt=0; kt<num_tiles; kt++) {
+        const size_t k_begin = kt * tile;
+        const size_t k_end = std::min(k_begin + tile, _numVertices);
+
+        // Diagonal tile
+        relax_tile(k_begin, k_end, k_begin, k_end, k_begin, k_end);
+
+        // Tiles in the diagonal tile's row and column
+        #pragma omp parallel for schedule(dynamic)
+        for (size_t t=0; t<num_tiles; t++) {
+            if (t == kt) continue;
+            const size_t t_begin = t * tile;
+            const size_t t_end = std::min(t_begin + tile, _numVertices);
+            relax_tile(k_begin, k_end, t_begin, t_end, k_begin, k_end);
+            relax_tile(t_begin, t_end, k_begin, k_end, k_begin, k_end);
+        }
+
+        // Remaining tiles
+        #pragma omp parallel for collapse(2) schedule(dynamic)
+        for (size_t it=0; it<num_tiles; it++) {
+            for (size_t jt=0; jt<num_tiles; jt++) {
+                if (it == kt || jt == kt) continue;
+                const size_t i_begin = it * tile;
+                const size_t j_begin = jt * tile;
+                relax_tile(i_begin, std::min(i_begin + tile, _numVertices),
+                           j_begin, std::min(j_begin + tile, _numVertices), k_begin, k_end);
+            }
+        }
     }
     
     auto FW_table_gen_stop = std::chrono::high_resolution_clock::now();
@@ -293,10 +1682,29 @@ std::vector<std::vector<float>> OoO_SimModel::FloydWarshall()
 void OoO_SimModel::SimulateModel(std::string execOrderFilename)
 {
     // Add initial events and run simulation
-    for (auto& event : _initEvents) {
-        _simExec->ScheduleInitEvent(event);
+    _simExec->ScheduleInitEvents(_initEvents);
+    
+    // itl_live_changes publishes tables while the simulation runs
+    std::atomic<bool> sim_done(false);
+    std::thread live_changes;
+    if (_options.ITLLiveChanges > 0) {
+        live_changes = std::thread(&OoO_SimModel::PublishLiveTopologyChanges, this, std::cref(sim_done));
+    }
+    
+    // Run the simulation, pipelined when requested, else in parallel when more than one thread is requested
+    if (_options.pipelined) {
+        _simExec->RunPipelinedSim(execOrderFilename);
+    } else if (_numThreads > 1) {
+        _simExec->RunParallelSim(execOrderFilename);
+    } else {
+        _simExec->RunSerialSim(execOrderFilename);
+    }
+    if (live_changes.joinable()) {
+        sim_done.store(true, std::memory_order_release);
+        live_changes.join();
     }
     
-    // Run the simulation
-    _simExec->RunSerialSim(execOrderFilename);
+    if ("auto" == _options.ITLHorizon) {
+        RecordE_RangeMax();
+    }
 }
\ No newline at end of file
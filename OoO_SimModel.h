@@ -3,13 +3,25 @@
 #include "Vertex.h"
 #include "OoO_SimExec.h"
 #include "OoO_SV.h"
+#include "OoO_SimOptions.h"
+#include "OoO_ITLMatrix.h"
+#include "OoO_ITLProvider.h"
+
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <random>
+
+class OoO_ParametricITL;
 
 class TriangularDist;
 class UniformIntDist;
 
 class OoO_SimModel {
 public:
-    OoO_SimModel(double maxSimTime, size_t numThreads, size_t distSeed, int numSerialOoO_Execs, std::string traceFolderName);
+    OoO_SimModel(double maxSimTime, size_t numThreads, size_t distSeed, int numSerialOoO_Execs, std::string traceFolderName,
+                 const OoO_SimOptions& options);
+    ~OoO_SimModel();
     
     // Set/get the number of vertices in the model
     void setNumVertices(size_t numVertices);
@@ -22,31 +34,181 @@ public:
     virtual void PrintSVs() const = 0;
     virtual void PrintNumVertexExecs() const = 0;
     
-    // Initialize the out-of-order simulation
-    void Init_OoO(std::string tableFilename);
+    // Initialize the out-of-order simulation; models that repeat on a periodic lattice pass its layout,
+    // which lets the ITL limits be stored per vertex-type pair and node offset instead of as a V x V table
+    void Init_OoO(std::string tableFilename, const OoO_LatticeLayout& layout = OoO_LatticeLayout());
+    
+    // Topology changes during a run, such as link failures and repairs. They may be queued from any
+    // thread and reach the ITL table at the next PublishITL.
+    void AddEdge(size_t origVertexIndex, size_t termVertexIndex, float minDist, int delayClass = Edge::_noDelayClass);
+    void RemoveEdge(size_t origVertexIndex, size_t termVertexIndex);
+    void AddSV_Dependency(size_t vertexIndex, size_t SV_Index, bool isOutput);
+    void RemoveSV_Dependency(size_t vertexIndex, size_t SV_Index, bool isOutput);
+    
+    // Apply the queued changes, update the shortest paths and ITL rows and columns they affect, and hand
+    // the new table to the event set. The first call builds the maintained shortest paths and ITL table.
+    // The table is dense, encoded as itl_encoding asks; runs on a lattice, tiled or horizon provider exit.
+    void PublishITL();
+    
+    // Check the maintained ITL table against MakeITL: rounds of numChanges random edge and SV changes are
+    // queued through the calls above and then undone, and the table is compared after each update.
+    // Exits on a mismatch.
+    void CheckMaintainedITL(size_t numChanges);
     
 protected:
     std::vector<std::vector<size_t>> _Is;       // Input state variables indices for each vertex
     std::vector<std::vector<size_t>> _Os;       // Output state variables indices for each vertex
     std::vector<std::vector<Edge>> _edges;      // Edges connecting vertices
-    std::vector<OoO_Event*> _initEvents;        // Initial events to start the simulation
+    OoO_EventSink _initEvents;                  // Initial events to start the simulation
     const size_t _distSeed;                     // Seed for random distributions
     const int _numSerialOoO_Execs;              // Controls OoO execution behavior
     const std::string _traceFolderName;         // Folder name for trace outputs
+    const OoO_SimOptions _options;              // Optional settings from the input file
     
 private:
+    // All-pairs shortest paths, by Dijkstra per source on sparse graphs and Floyd-Warshall otherwise
+    OoO_ITLMatrix ShortestPaths();
+    
     // Floyd-Warshall algorithm to compute shortest paths
-    std::vector<std::vector<float>> FloydWarshall();
+    OoO_ITLMatrix FloydWarshall();
+    
+    // Dijkstra's algorithm from every source, in parallel, to compute shortest paths
+    OoO_ITLMatrix DijkstraAllPairs();
+    
+    // Compressed adjacency lists of the edges, for Dijkstra
+    struct Adjacency {
+        std::vector<size_t> offsets;
+        std::vector<size_t> targets;
+        std::vector<float> delays;
+    };
+    Adjacency BuildAdjacency() const;
+    
+    // Shortest paths from one source into dist, using queue as heap storage. Paths of horizon or more
+    // are not followed; reached, if given, collects the vertices given a distance.
+    typedef std::pair<float, size_t> QueueEntry;
+    static void DijkstraFrom(size_t source, const Adjacency& adjacency, float* dist, std::vector<QueueEntry>& queue,
+                             float horizon = std::numeric_limits<float>::max(), std::vector<size_t>* reached = nullptr);
+    
+    // Shortest paths from the nearest of several sources into dist, which must start at FLT_MAX
+    static void DijkstraFromSources(const std::vector<size_t>& sources, const Adjacency& adjacency, float* dist,
+                                    std::vector<QueueEntry>& queue);
+    
+    // ITL limits of a periodic model, per vertex-type pair and node offset; false if the model is not
+    // invariant under the lattice translations
+    bool MakeLatticeITL(const OoO_LatticeLayout& layout, std::vector<float>& offsetLimits) const;
     
     // Generate Independence Time Limit (ITL) table
-    std::vector<std::vector<float>> MakeITL(std::string tableFilename);
+    OoO_ITLMatrix MakeITL();
+    
+    // ITL limits below the horizon, by Dijkstra stopped at the horizon from every vertex; time and
+    // memory grow with the vertices within the horizon of each vertex rather than with V^2
+    OoO_DependentPairs MakeHorizonITL(float horizon) const;
+    
+    // Dense ITL table written to tablePath in tiles, one block of later-vertex columns in memory at a
+    // time, each column by one Dijkstra over the reversed edges; false if the file cannot be written
+    bool MakeTiledITL(const std::string& tablePath, uint64_t fingerprint) const;
+    
+    // Zero ITL limits after phase two: for each vertex i, the later vertices l with ITL i-l == 0, given
+    // the later vertices whose SVs each vertex can update
+    std::vector<std::vector<size_t>> ZeroLimits(const Adjacency& adjacency,
+                                                const std::vector<std::vector<size_t>>& updates) const;
+    
+    // Horizon from the itl_horizon option: a given time, or for auto 1.5 times the largest event-set
+    // range recorded by earlier runs of the model, or 16 times the largest edge delay without a record
+    float ITL_Horizon() const;
+    
+    // Keep the largest event-set range of this run for later itl_horizon auto runs
+    void RecordE_RangeMax() const;
     
-    // Read and write ITL tables to/from CSV
-    std::vector<std::vector<float>> ReadITLTableFromCSV(const std::string& tableFilename) const;
-    void WriteITLTableToCSV(std::vector<std::vector<float>>& ITL, std::string tableFilename) const;
+    // Lower phase-one ITL values through vertices that the later vertex affects immediately
+    void ITL_PhaseTwo(OoO_ITLMatrix& ITL, const OoO_ITLMatrix& shortestPaths) const;
+    
+    // Hash of the model inputs to the ITL table, which keys the binary table cache; without the delays
+    // (only their classes) it identifies the topology, which keys the parametric table cache
+    uint64_t ModelFingerprint(bool withDelays) const;
+    
+    // Vertices that can update the SVs of each vertex k (U_Sk in MakeITL), sorted
+    std::vector<std::vector<size_t>> SV_WriterSets() const;
+    
+    // Delay of each edge class, or false if some edge has no class or a class has different delays
+    bool EdgeDelayClasses(std::vector<float>& classDelays) const;
+    
+    // ITL table evaluated from this topology's parametric table, built and cached on first use;
+    // empty if the table has too many candidate paths
+    OoO_ITLMatrix EvaluateParametricITL(const std::vector<float>& classDelays) const;
+    bool MakeParametricITL(OoO_ParametricITL& parametric) const;
+    
+    // Provider for a dense table, encoded as the itl_encoding option asks; a float table keeps the
+    // transpose if one is given
+    OoO_ITLProvider DenseITLProvider(OoO_ITLMatrix ITL, OoO_ITLMatrix ITL_T = OoO_ITLMatrix()) const;
+    
+    // Dense table mapped from the binary cache, or built and cached
+    OoO_ITLMatrix LoadITL(const std::string& tableFilename, uint64_t fingerprint);
+    
+    // Dense table and its transpose in POSIX shared memory, named by the model fingerprint: the first run
+    // loads or builds them and publishes them, later runs map them read-only, and the last run to finish
+    // removes them
+    OoO_ITLMatrix SharedITL(const std::string& tableFilename, uint64_t fingerprint, OoO_ITLMatrix& ITL_T);
+    
+    // Largest delay every positive edge minimum is a whole multiple of, the quantum8 step: shortest
+    // paths, and so the ITL limits, are multiples of it too
+    float DelayQuantum() const;
+    
+    // Write the ITL table to CSV, for inspection
+    void WriteITLTableToCSV(const OoO_ITLMatrix& ITL, std::string tableFilename) const;
+    
+    // Queued topology change
+    struct TopologyChange {
+        enum Kind { EdgeAdded, EdgeRemoved, InputAdded, InputRemoved, OutputAdded, OutputRemoved };
+        Kind kind;
+        size_t vertexIndex;     // Edge origin, or the vertex whose SVs change
+        size_t other;           // Edge end, or the SV index
+        float minDist;
+        int delayClass;
+    };
+    void QueueTopologyChange(const TopologyChange& change);
+    void ApplyTopologyChange(const TopologyChange& change);
+    
+    // Queue numChanges random edge and SV changes, only additions when additionsOnly, and collect the
+    // changes that undo them; false if the model has no edges or SVs
+    bool QueueRandomTopologyChanges(size_t numChanges, bool additionsOnly, std::mt19937_64& rng,
+                                    std::vector<TopologyChange>& undo);
+    
+    // itl_live_changes: publish tables with random added edges and SV dependencies, then without them,
+    // until the run is done
+    void PublishLiveTopologyChanges(const std::atomic<bool>& simDone);
+    
+    // Maintained ITL state. Phase two takes the closure of the zero limits, as MakeITL does.
+    // MaintainITL applies the queued changes under _topologyMutex and returns how many there were.
+    size_t MaintainITL();
+    void InitMaintainedITL();
+    void UpdateMaintainedITL(const std::vector<TopologyChange>& changes);
+    void ComputeMaintainedZeros(std::vector<std::vector<size_t>>& zeros) const;
+    float MaintainedPhaseOne(size_t j, size_t k) const;
+    float MaintainedLimit(size_t h, size_t i) const;
+    
+    static constexpr size_t _FW_TileSize = 64;  // Floyd-Warshall tile edge: a 64x64 float tile fits in L1
+    static constexpr size_t _minPlusTileSize = 2048; // Phase-two output block: 8 KB of floats
+    static constexpr size_t _ITL_CheckRounds = 4;    // CheckMaintainedITL rounds of changes
+    static constexpr int _liveChangesPeriodMs = 10;  // itl_live_changes: pause after each publish
+    static constexpr float _horizonRangeMargin = 1.5f;      // Auto horizon over the recorded event-set range
+    static constexpr float _horizonDefaultEdgeDelays = 16;  // Auto horizon without a record, in largest edge delays
+    static constexpr size_t _latticeITL_MinVertices = 16384; // Auto provider: the dense table would take 1 GB or more
+    static constexpr double _tiledITL_MemoryFraction = 0.5;  // Auto provider: tiled once the dense table exceeds this share of RAM
     
     std::unique_ptr<OoO_SimExec> _simExec;      // Simulation executor
+    std::string _ITLProviderKind;               // Provider the executor was given: matrix, lattice, tiled or horizon
     size_t _numVertices;                        // Number of vertices in the model
     const double _maxSimTime;                   // Maximum simulation time
     const size_t _numThreads;                   // Number of threads for execution
+    int _sharedITL_LockFd = -1;                 // Lock object of the shared ITL table, held shared while it is in use
+    std::string _sharedITL_Name;                // Shared-memory name of the shared ITL table
+    
+    std::mutex _topologyMutex;                  // Guards the queued changes and the maintained state
+    std::vector<TopologyChange> _pendingChanges;
+    OoO_ITLMatrix _maintainedPaths;             // Shortest paths
+    OoO_ITLMatrix _maintainedPhaseOne;          // Phase-one ITL values
+    OoO_ITLMatrix _maintainedITL;               // Published ITL table
+    std::vector<std::vector<size_t>> _maintainedWriters;    // SV_WriterSets()
+    std::vector<std::vector<size_t>> _maintainedZeros;      // Vertices l with ITL i-l == 0, for each i
 };
\ No newline at end of file
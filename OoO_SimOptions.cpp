@@ -0,0 +1,83 @@
+#include "OoO_SimOptions.h"
+
+#include <cstdlib>
+#include <iostream>
+
+void OoO_SimOptions::Read(std::istream& inFile)
+{
+    std::string key;
+    std::string value;
+    while (getline(inFile, key, ':') && inFile >> value) {
+        // Strip the newline and padding left around the key
+        key.erase(0, key.find_first_not_of(" \t\r\n"));
+        key.erase(key.find_last_not_of(" \t\r\n") + 1);
+        if (key.empty()) continue;
+
+        if (Set(key, value)) {
+            std::cout << "\n" << key << ": " << value;
+        } else {
+            std::cerr << "Warning: unknown input option '" << key << "' ignored" << std::endl;
+        }
+    }
+}
+
+bool OoO_SimOptions::Set(const std::string& key, const std::string& value)
+{
+    if ("event_set_backend" == key) {
+        eventSetBackend = value;
+        return true;
+    }
+    if ("thread_scheduler" == key) {
+        threadScheduler = value;
+        return true;
+    }
+    if ("pipeline" == key) {
+        if ("on" != value && "off" != value) {
+            std::cerr << "Warning: pipeline '" << value << "' is not on or off, keeping " << (pipelined ? "on" : "off") << std::endl;
+        } else {
+            pipelined = ("on" == value);
+        }
+        return true;
+    }
+    if ("itl_provider" == key) {
+        ITLProvider = value;
+        return true;
+    }
+    if ("itl_horizon" == key) {
+        ITLHorizon = value;
+        return true;
+    }
+    if ("itl_encoding" == key) {
+        ITLEncoding = value;
+        return true;
+    }
+    if ("itl_shared" == key) {
+        if ("on" != value && "off" != value) {
+            std::cerr << "Warning: itl_shared '" << value << "' is not on or off, keeping " << (ITLShared ? "on" : "off") << std::endl;
+        } else {
+            ITLShared = ("on" == value);
+        }
+        return true;
+    }
+    if ("itl_tile_cache_mb" == key) {
+        char* end = nullptr;
+        unsigned long long megabytes = std::strtoull(value.c_str(), &end, 10);
+        if (end == value.c_str() || '\0' != *end) {
+            std::cerr << "Warning: itl_tile_cache_mb '" << value << "' is not a number, keeping " << ITLTileCacheMB << std::endl;
+        } else {
+            ITLTileCacheMB = static_cast<size_t>(megabytes);
+        }
+        return true;
+    }
+    if ("itl_live_changes" == key) {
+        char* end = nullptr;
+        unsigned long long num_changes = std::strtoull(value.c_str(), &end, 10);
+        if (end == value.c_str() || '\0' != *end) {
+            std::cerr << "Warning: itl_live_changes '" << value << "' is not a number, keeping " << ITLLiveChanges << std::endl;
+        } else {
+            ITLLiveChanges = static_cast<size_t>(num_changes);
+        }
+        return true;
+    }
+    return false;
+}
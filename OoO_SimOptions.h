@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+#include <istream>
+
+// Optional simulation settings, read from "key : value" lines following the required input-file fields
+struct OoO_SimOptions {
+    std::string eventSetBackend = "multiset";   // Pending-event-set backend (multiset, calendar, ladder, heap)
+    std::string threadScheduler = "stealing";   // Parallel execution of ready events: stealing (per-thread work-stealing deques) or shared (one task counter)
+    bool pipelined = false;                     // Ready-event discovery overlapped with event execution (pipeline on/off)
+    std::string ITLProvider = "auto";           // ITL storage (matrix, lattice, tiled, or auto: lattice for large periodic models,
+                                                // tiled when the dense table would not fit in memory)
+    std::string ITLEncoding = "float";          // Dense ITL values as float, fixed16 (16-bit fixed point) or quantum8 (8-bit delay multiples)
+    std::string ITLHorizon = "off";             // ITL limits kept only below a horizon: off, auto (from recorded event-set ranges) or a time
+    size_t ITLTileCacheMB = 1024;               // Resident tiles of a tiled ITL table, in MB
+    bool ITLShared = false;                     // Dense ITL table shared with concurrent runs through POSIX shared memory (on/off)
+    bool ITL_Only = false;                      // Build the model structure and cache its ITL table, without traces or a run (set by ITL_Gen)
+    size_t ITLLiveChanges = 0;                  // Check run: publish ITL tables with this many added edges or SV dependencies, and their undoing, throughout the run
+    size_t ITLCheckChanges = 0;                 // Check the maintained ITL table with rounds of this many topology changes instead (set by ITL_Gen -check)
+
+    // Read the remaining "key : value" lines of an input file; unknown keys are reported and skipped
+    void Read(std::istream& inFile);
+
+    // Apply a single setting, returning false for an unknown key
+    bool Set(const std::string& key, const std::string& value);
+};
@@ -0,0 +1,240 @@
+#include "OoO_ThreadPool.h"
+
+#include <algorithm>
+
+OoO_ThreadPool::OoO_ThreadPool(size_t numThreads, Scheduler scheduler)
+: _task(nullptr), _numTasks(0), _nextTask(0), _numActive(0), _generation(0), _stop(false),
+  _scheduler(scheduler), _deques(std::make_unique<OoO_WorkDeque[]>(std::max<size_t>(numThreads, 1))), _numSteals(0),
+  _streaming(false), _streamOpen(false), _numSubmitted(0), _numSleeping(0)
+{
+    for (size_t i=1; i<numThreads; i++) {
+        _workers.emplace_back(&OoO_ThreadPool::WorkerLoop, this, i);
+    }
+}
+
+bool OoO_ThreadPool::ParseScheduler(const std::string& name, Scheduler& scheduler)
+{
+    if ("shared" == name) {
+        scheduler = Shared;
+        return true;
+    }
+    if ("stealing" == name) {
+        scheduler = WorkStealing;
+        return true;
+    }
+    return false;
+}
+
+OoO_ThreadPool::~OoO_ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _startCV.notify_all();
+    for (auto& worker : _workers) {
+        worker.join();
+    }
+}
+
+void OoO_ThreadPool::ParallelFor(size_t numTasks, const std::function<void(size_t)>& task)
+{
+    if (0 == numTasks) return;
+
+    // Not worth waking the workers for a single task
+    if (1 == numTasks || _workers.empty()) {
+        for (size_t i=0; i<numTasks; i++) task(i);
+        return;
+    }
+
+    // Each thread's deque starts with a contiguous share of the tasks; no thread is running yet, and
+    // the region start below publishes them
+    if (WorkStealing == _scheduler) {
+        const size_t num_threads = getNumThreads();
+        for (size_t t=0; t<num_threads; t++) {
+            const size_t begin = numTasks * t / num_threads;
+            const size_t end = numTasks * (t + 1) / num_threads;
+            _deques[t].Reset(end - begin);
+            for (size_t i=begin; i<end; i++) _deques[t].Push(i);
+        }
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _task = &task;
+        _streaming = false;
+        _numTasks = numTasks;
+        _nextTask.store(0);
+        _numActive = _workers.size();
+        _generation++;
+    }
+    _startCV.notify_all();
+
+    // Calling thread claims tasks alongside the workers
+    RunTasks(0);
+
+    // Wait for the workers to leave the region before the task goes out of scope
+    std::unique_lock<std::mutex> lock(_mutex);
+    _doneCV.wait(lock, [this] { return 0 == _numActive; });
+    _task = nullptr;
+}
+
+void OoO_ThreadPool::BeginStream(const std::function<void(size_t)>& task)
+{
+    _deques[0].Reset(_streamCapacity);
+    _numSubmitted.store(0);
+    _numSleeping.store(0);
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _task = &task;
+        _streaming = true;
+        _streamOpen.store(true);
+        _numActive = _workers.size();
+        _generation++;
+    }
+    _startCV.notify_all();
+}
+
+void OoO_ThreadPool::Submit(size_t token)
+{
+    while (_deques[0].Size() >= _streamCapacity) {
+        RunSubmitted();
+    }
+    _deques[0].Push(token);
+
+    // A worker counts itself as sleeping before it reads _numSubmitted and rechecks the queue, so
+    // either it sees this token or this thread sees it sleeping and wakes it
+    _numSubmitted.fetch_add(1);
+    if (0 < _numSleeping.load()) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _streamCV.notify_all();
+    }
+}
+
+bool OoO_ThreadPool::RunSubmitted()
+{
+    size_t token = _deques[0].Pop();
+    if (OoO_WorkDeque::_empty == token) return false;
+    (*_task)(token);
+    return true;
+}
+
+void OoO_ThreadPool::EndStream()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _streamOpen.store(false);
+    }
+    _streamCV.notify_all();
+
+    while (RunSubmitted()) {}
+
+    // Wait for the workers to leave the region before the task goes out of scope
+    std::unique_lock<std::mutex> lock(_mutex);
+    _doneCV.wait(lock, [this] { return 0 == _numActive; });
+    _task = nullptr;
+    _streaming = false;
+}
+
+void OoO_ThreadPool::RunStream()
+{
+    OoO_WorkDeque& queue = _deques[0];
+    int num_empty = 0;
+    while (true) {
+        // Every token is queued before the stream closes, so an empty queue after it closed stays empty
+        bool open = _streamOpen.load();
+        bool lost;
+        size_t token = queue.Steal(lost);
+        if (OoO_WorkDeque::_empty != token) {
+            (*_task)(token);
+            num_empty = 0;
+            continue;
+        }
+        if (lost) continue;
+        if (!open) return;
+        if (++num_empty < _streamSpins) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        _numSleeping.fetch_add(1);
+        size_t seen_submitted = _numSubmitted.load();
+        if (0 == queue.Size() && _streamOpen.load()) {
+            _streamCV.wait(lock, [this, seen_submitted] {
+                return _numSubmitted.load() != seen_submitted || !_streamOpen.load();
+            });
+        }
+        _numSleeping.fetch_sub(1);
+        num_empty = 0;
+    }
+}
+
+void OoO_ThreadPool::RunTasks(size_t threadIndex)
+{
+    if (_streaming) {
+        RunStream();
+        return;
+    }
+    if (WorkStealing == _scheduler) {
+        RunStealing(threadIndex);
+        return;
+    }
+    for (size_t i = _nextTask.fetch_add(1); i < _numTasks; i = _nextTask.fetch_add(1)) {
+        (*_task)(i);
+    }
+}
+
+void OoO_ThreadPool::RunStealing(size_t threadIndex)
+{
+    OoO_WorkDeque& own = _deques[threadIndex];
+    for (size_t i = own.Pop(); OoO_WorkDeque::_empty != i; i = own.Pop()) {
+        (*_task)(i);
+    }
+
+    // No tasks are added during a region, so once a pass finds every deque empty without losing a
+    // race, the remaining tasks are all running and this thread is done
+    const size_t num_threads = getNumThreads();
+    uint64_t random = 0x9E3779B97F4A7C15ull * (threadIndex + 1);
+    bool retry = true;
+    while (retry) {
+        retry = false;
+        random ^= random << 13;
+        random ^= random >> 7;
+        random ^= random << 17;
+        const size_t first_victim = random % num_threads;
+        for (size_t v=0; v<num_threads; v++) {
+            size_t victim = (first_victim + v) % num_threads;
+            if (victim == threadIndex) continue;
+            bool lost;
+            size_t i = _deques[victim].Steal(lost);
+            if (OoO_WorkDeque::_empty != i) {
+                _numSteals.fetch_add(1, std::memory_order_relaxed);
+                (*_task)(i);
+                retry = true;
+                break;
+            }
+            retry = retry || lost;
+        }
+    }
+}
+
+void OoO_ThreadPool::WorkerLoop(size_t threadIndex)
+{
+    size_t seen_generation = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _startCV.wait(lock, [this, seen_generation] { return _stop || _generation != seen_generation; });
+            if (_stop) return;
+            seen_generation = _generation;
+        }
+
+        RunTasks(threadIndex);
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (0 == --_numActive) _doneCV.notify_one();
+        }
+    }
+}
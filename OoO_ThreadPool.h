@@ -0,0 +1,88 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "OoO_WorkDeque.h"
+
+// Persistent pool of worker threads used to execute ready events in parallel. With the shared
+// scheduler every thread claims the next task from one atomic counter. With the work-stealing
+// scheduler each thread starts on its own contiguous share of the tasks, held in a Chase-Lev deque,
+// and a thread that runs out steals the oldest tasks of a random other thread. Threads then rarely
+// touch shared state, and a few slow tasks cannot leave the rest of the pool idle. A streaming region
+// instead runs tasks the caller submits one at a time while it keeps working, until it ends the stream.
+class OoO_ThreadPool {
+public:
+    enum Scheduler { Shared, WorkStealing };
+
+    // The calling thread takes part in every parallel region, so numThreads-1 workers are spawned
+    OoO_ThreadPool(size_t numThreads, Scheduler scheduler = WorkStealing);
+    ~OoO_ThreadPool();
+
+    OoO_ThreadPool(const OoO_ThreadPool&) = delete;
+    OoO_ThreadPool& operator=(const OoO_ThreadPool&) = delete;
+
+    // Run task(i) for every i in [0, numTasks), returning once all tasks have finished
+    void ParallelFor(size_t numTasks, const std::function<void(size_t)>& task);
+
+    // Start a streaming region: the workers run task(token) for each token passed to Submit, while the
+    // caller goes on with other work. Tokens are queued in the caller's deque, and the workers steal them.
+    void BeginStream(const std::function<void(size_t)>& task);
+
+    // Caller only: queue a token, running queued tasks itself while the queue is full
+    void Submit(size_t token);
+
+    // Caller only: run the most recently queued task; false when the queue is empty
+    bool RunSubmitted();
+
+    // Run the tasks still queued, and return once every submitted task has finished
+    void EndStream();
+
+    size_t getNumThreads() const { return _workers.size() + 1; }
+    Scheduler getScheduler() const { return _scheduler; }
+
+    // Scheduler named by the thread_scheduler option: shared or stealing; false for an unknown name
+    static bool ParseScheduler(const std::string& name, Scheduler& scheduler);
+
+    // Tasks taken from another thread's deque so far
+    size_t getNumSteals() const { return _numSteals.load(std::memory_order_relaxed); }
+
+private:
+    void WorkerLoop(size_t threadIndex);
+    void RunTasks(size_t threadIndex);
+
+    // Work-stealing region: own tasks newest first, then steals until every deque is empty
+    void RunStealing(size_t threadIndex);
+
+    // Streaming region: steal submitted tokens, spinning briefly and then sleeping while none are queued
+    void RunStream();
+
+    std::vector<std::thread> _workers;              // Worker threads (excluding the calling thread)
+    std::mutex _mutex;                              // Protects generation, stop flag and active count
+    std::condition_variable _startCV;               // Signals workers that a new parallel region began
+    std::condition_variable _doneCV;                // Signals caller that all workers left the region
+    const std::function<void(size_t)>* _task;       // Task of the current parallel region
+    size_t _numTasks;                               // Number of tasks in the current parallel region
+    std::atomic<size_t> _nextTask;                  // Next unclaimed task index
+    size_t _numActive;                              // Workers still inside the current region
+    size_t _generation;                             // Parallel-region counter
+    bool _stop;                                     // Set when the pool is destroyed
+
+    const Scheduler _scheduler;
+    std::unique_ptr<OoO_WorkDeque[]> _deques;       // Work-stealing deque of each thread, the caller's first
+    std::atomic<size_t> _numSteals;
+
+    static constexpr size_t _streamCapacity = 4096; // Queued tokens before Submit runs tasks itself
+    static constexpr int _streamSpins = 64;         // Empty steals before a streaming worker sleeps
+    bool _streaming;                                // The current region is a streaming region
+    std::atomic<bool> _streamOpen;                  // Cleared by EndStream, under _mutex
+    std::atomic<size_t> _numSubmitted;              // Tokens submitted in the current stream
+    std::atomic<size_t> _numSleeping;               // Streaming workers waiting on _streamCV
+    std::condition_variable _streamCV;              // Signals sleeping workers of new tokens or the end of the stream
+};
@@ -0,0 +1,177 @@
+#include "OoO_TiledITL.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char TITL_FileMagic[8] = {'O', 'o', 'O', '_', 'T', 'I', 'T', 'L'};
+
+// Whole-buffer pwrite and pread, retrying short transfers
+static bool WriteAll(int fd, const void* data, size_t bytes, off_t offset)
+{
+    const char* bytes_data = static_cast<const char*>(data);
+    while (bytes > 0) {
+        ssize_t written = pwrite(fd, bytes_data, bytes, offset);
+        if (written <= 0) return false;
+        bytes_data += written;
+        bytes -= written;
+        offset += written;
+    }
+    return true;
+}
+
+static bool ReadAll(int fd, void* data, size_t bytes, off_t offset)
+{
+    char* bytes_data = static_cast<char*>(data);
+    while (bytes > 0) {
+        ssize_t read_bytes = pread(fd, bytes_data, bytes, offset);
+        if (read_bytes <= 0) return false;
+        bytes_data += read_bytes;
+        bytes -= read_bytes;
+        offset += read_bytes;
+    }
+    return true;
+}
+
+OoO_TiledITL::Writer::Writer(const std::string& filename, size_t numVertices, uint64_t fingerprint)
+: _filename(filename), _tempFilename(filename + ".tmp" + std::to_string(getpid())), _numVertices(numVertices),
+  _numBlocks((numVertices + _tileSize - 1) / _tileSize), _numWritten(0), _tile(_tileSize * _tileSize)
+{
+    _fd = open(_tempFilename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (_fd < 0) return;
+
+    FileHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, TITL_FileMagic, sizeof(TITL_FileMagic));
+    header.version = _fileVersion;
+    header.tileSize = _tileSize;
+    header.numVertices = numVertices;
+    header.fingerprint = fingerprint;
+    if (!WriteAll(_fd, &header, sizeof(header), 0)) {
+        close(_fd);
+        _fd = -1;
+    }
+}
+
+OoO_TiledITL::Writer::~Writer()
+{
+    if (_fd >= 0) {
+        close(_fd);
+        std::remove(_tempFilename.c_str());
+    }
+}
+
+bool OoO_TiledITL::Writer::WriteBlock(const float* columns)
+{
+    if (_fd < 0 || _numWritten == _numBlocks) return false;
+
+    // Tiles past the last vertex are padded with "never"
+    const size_t block_begin = _numWritten * _tileSize;
+    const size_t block_size = std::min(_tileSize, _numVertices - block_begin);
+    const size_t tile_bytes = _tile.size() * sizeof(float);
+    for (size_t j_block=0; j_block<_numBlocks; j_block++) {
+        const size_t j_begin = j_block * _tileSize;
+        const size_t j_size = std::min(_tileSize, _numVertices - j_begin);
+        std::fill(_tile.begin(), _tile.end(), std::numeric_limits<float>::max());
+        for (size_t i=0; i<block_size; i++) {
+            std::copy_n(&columns[i * _numVertices + j_begin], j_size, &_tile[i * _tileSize]);
+        }
+        off_t offset = sizeof(FileHeader) + (_numWritten * _numBlocks + j_block) * tile_bytes;
+        if (!WriteAll(_fd, _tile.data(), tile_bytes, offset)) return false;
+    }
+    _numWritten++;
+    return true;
+}
+
+bool OoO_TiledITL::Writer::Close()
+{
+    if (_fd < 0) return false;
+    bool complete = (_numWritten == _numBlocks);
+    complete = (0 == close(_fd)) && complete;
+    _fd = -1;
+
+    // Rename into place, so concurrent runs never open a partial table
+    if (!complete || 0 != std::rename(_tempFilename.c_str(), _filename.c_str())) {
+        std::remove(_tempFilename.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::shared_ptr<OoO_TiledITL> OoO_TiledITL::Open(const std::string& filename, uint64_t fingerprint, size_t cacheBytes)
+{
+    int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    struct stat file_stat;
+    FileHeader header;
+    const size_t tile_bytes = _tileSize * _tileSize * sizeof(float);
+    bool valid = (0 == fstat(fd, &file_stat)) && ReadAll(fd, &header, sizeof(header), 0)
+              && (0 == std::memcmp(header.magic, TITL_FileMagic, sizeof(TITL_FileMagic)))
+              && (_fileVersion == header.version) && (_tileSize == header.tileSize)
+              && (fingerprint == header.fingerprint) && (0 < header.numVertices);
+    if (valid) {
+        size_t num_blocks = (header.numVertices + _tileSize - 1) / _tileSize;
+        valid = (static_cast<size_t>(file_stat.st_size) == sizeof(header) + num_blocks * num_blocks * tile_bytes);
+    }
+    if (!valid) {
+        close(fd);
+        return nullptr;
+    }
+
+    // Room for at least a full row of tiles, and no more tiles than the table has
+    size_t num_blocks = (header.numVertices + _tileSize - 1) / _tileSize;
+    size_t num_cached_tiles = std::max(cacheBytes / tile_bytes, num_blocks);
+    num_cached_tiles = std::min(num_cached_tiles, num_blocks * num_blocks);
+    return std::shared_ptr<OoO_TiledITL>(new OoO_TiledITL(fd, header.numVertices, num_cached_tiles));
+}
+
+OoO_TiledITL::OoO_TiledITL(int fd, size_t numVertices, size_t numCachedTiles)
+: _fd(fd), _numVertices(numVertices), _numBlocks((numVertices + _tileSize - 1) / _tileSize),
+  _slots(numCachedTiles * _tileSize * _tileSize), _slotTiles(numCachedTiles, SIZE_MAX), _slotReferenced(numCachedTiles, 0),
+  _slotOf(_numBlocks * _numBlocks, _noSlot), _clockHand(0), _lastTile(SIZE_MAX), _lastTileData(nullptr), _numTileReads(0)
+{}
+
+OoO_TiledITL::~OoO_TiledITL()
+{
+    close(_fd);
+}
+
+const float* OoO_TiledITL::ResidentTile(size_t tile) const
+{
+    const size_t tile_floats = _tileSize * _tileSize;
+    uint32_t slot = _slotOf[tile];
+    if (_noSlot != slot) {
+        _slotReferenced[slot] = 1;
+        return &_slots[slot * tile_floats];
+    }
+
+    // Clock: pass over referenced slots, clearing their bits, and replace the first unreferenced one
+    while (_slotReferenced[_clockHand]) {
+        _slotReferenced[_clockHand] = 0;
+        _clockHand = (_clockHand + 1) % _slotTiles.size();
+    }
+    slot = static_cast<uint32_t>(_clockHand);
+    _clockHand = (_clockHand + 1) % _slotTiles.size();
+    if (SIZE_MAX != _slotTiles[slot]) {
+        _slotOf[_slotTiles[slot]] = _noSlot;
+    }
+
+    float* data = &_slots[slot * tile_floats];
+    if (!ReadAll(_fd, data, tile_floats * sizeof(float), sizeof(FileHeader) + tile * tile_floats * sizeof(float))) {
+        std::cerr << "Error: cannot read ITL tile " << tile << " from the tiled table" << std::endl;
+        exit(1);
+    }
+    _slotTiles[slot] = tile;
+    _slotReferenced[slot] = 1;
+    _slotOf[tile] = slot;
+    _numTileReads++;
+    return data;
+}
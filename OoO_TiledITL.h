@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// ITL table kept on disk as square tiles, for models whose dense table does not fit in memory. Tile
+// (later block, earlier block) holds the limits from the earlier block's vertices to the later block's
+// vertices, each later vertex's limits contiguous. Tiles are stored later block by later block, the
+// order the generator produces them in. Reads go through a fixed budget of resident tiles, replaced by
+// the clock algorithm. Consecutive vertex numbers share tiles, so checks for neighbouring vertices
+// mostly hit tiles that are already resident. The cache is not thread-safe; like the event window, it
+// is only used by the thread driving the event set.
+class OoO_TiledITL {
+public:
+    static constexpr size_t _tileSize = 256;   // Tile edge in vertices: a 256 KB tile
+
+    // Open a tiled table file with a cache of about cacheBytes; nullptr if the file is missing, from
+    // another format version, or was written for a different model fingerprint
+    static std::shared_ptr<OoO_TiledITL> Open(const std::string& filename, uint64_t fingerprint, size_t cacheBytes);
+
+    // Writes a tiled table file one block of later vertices at a time, under a temporary name that
+    // Close renames into place
+    class Writer {
+    public:
+        Writer(const std::string& filename, size_t numVertices, uint64_t fingerprint);
+        ~Writer();
+
+        size_t NumBlocks() const { return _numBlocks; }
+
+        // Limits of later block b: column i of the block (vertex b * _tileSize + i) at columns[i * numVertices]
+        bool WriteBlock(const float* columns);
+        bool Close();
+
+    private:
+        std::string _filename;
+        std::string _tempFilename;
+        size_t _numVertices;
+        size_t _numBlocks;
+        size_t _numWritten;
+        int _fd;
+        std::vector<float> _tile;
+    };
+
+    ~OoO_TiledITL();
+    OoO_TiledITL(const OoO_TiledITL&) = delete;
+    OoO_TiledITL& operator=(const OoO_TiledITL&) = delete;
+
+    size_t size() const { return _numVertices; }
+
+    // ITL limit from earlier-event vertex j to later-event vertex k
+    float operator()(size_t j, size_t k) const {
+        return TileColumn(k, j / _tileSize)[j % _tileSize];
+    }
+
+    // Limits from the vertices of earlier block jBlock to vertex k, valid until the next read misses
+    const float* TileColumn(size_t k, size_t jBlock) const {
+        size_t tile = (k / _tileSize) * _numBlocks + jBlock;
+        if (tile != _lastTile) {
+            _lastTile = tile;
+            _lastTileData = ResidentTile(tile);
+        }
+        return _lastTileData + (k % _tileSize) * _tileSize;
+    }
+
+    size_t getNumTileReads() const { return _numTileReads; }     // Cache misses so far
+    size_t getCacheTiles() const { return _slotTiles.size(); }    // Cache capacity in tiles
+
+private:
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t tileSize;
+        uint64_t numVertices;
+        uint64_t fingerprint;
+        char padding[32];
+    };
+    static_assert(sizeof(FileHeader) == 64, "Tiled ITL file header must fill one cache line");
+    static constexpr uint32_t _fileVersion = 1;
+    static constexpr uint32_t _noSlot = UINT32_MAX;
+
+    OoO_TiledITL(int fd, size_t numVertices, size_t numCachedTiles);
+
+    // Tile data, read into a cache slot on a miss
+    const float* ResidentTile(size_t tile) const;
+
+    int _fd;
+    size_t _numVertices;
+    size_t _numBlocks;
+
+    mutable std::vector<float> _slots;              // Cached tiles, _tileSize^2 floats each
+    mutable std::vector<size_t> _slotTiles;         // Tile held by each slot
+    mutable std::vector<uint8_t> _slotReferenced;   // Clock reference bits
+    mutable std::vector<uint32_t> _slotOf;          // Slot holding each tile, or _noSlot
+    mutable size_t _clockHand;
+    mutable size_t _lastTile;                       // Most recent tile, checked before the slot lookup
+    mutable const float* _lastTileData;
+    mutable size_t _numTileReads;
+};
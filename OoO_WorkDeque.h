@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+// Chase-Lev work-stealing deque of task indices (Le, Pop, Cohen and Zappa Nardelli's C11 formulation).
+// The owning thread pushes and pops at the bottom; other threads steal from the top. The capacity is
+// fixed by Reset, which may only be called while no other thread uses the deque.
+class OoO_WorkDeque {
+public:
+    static constexpr size_t _empty = SIZE_MAX;   // Returned by Pop and Steal when there is nothing to take
+
+    OoO_WorkDeque() : _top(0), _bottom(0), _mask(0) {}
+
+    // Empty the deque, with room for at least capacity tasks
+    void Reset(size_t capacity) {
+        size_t size = 1;
+        while (size < capacity) size *= 2;
+        if (!_tasks || size > _mask + 1) {
+            _tasks = std::make_unique<std::atomic<size_t>[]>(size);
+            _mask = size - 1;
+        }
+        _top.store(0, std::memory_order_relaxed);
+        _bottom.store(0, std::memory_order_relaxed);
+    }
+
+    // Owner only; the caller keeps within the capacity
+    void Push(size_t task) {
+        int64_t bottom = _bottom.load(std::memory_order_relaxed);
+        _tasks[bottom & _mask].store(task, std::memory_order_relaxed);
+        _bottom.store(bottom + 1, std::memory_order_release);
+    }
+
+    // Owner only: most recently pushed task
+    size_t Pop() {
+        int64_t bottom = _bottom.load(std::memory_order_relaxed) - 1;
+        _bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = _top.load(std::memory_order_relaxed);
+        if (top > bottom) {
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+            return _empty;
+        }
+        size_t task = _tasks[bottom & _mask].load(std::memory_order_relaxed);
+        if (top == bottom) {
+            // Last task: race the thieves for it
+            if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                task = _empty;
+            }
+            _bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return task;
+    }
+
+    // Any thread: oldest task. Sets lost if another thread took it first, in which case the deque may
+    // still hold tasks.
+    size_t Steal(bool& lost) {
+        lost = false;
+        int64_t top = _top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t bottom = _bottom.load(std::memory_order_acquire);
+        if (top >= bottom) return _empty;
+        size_t task = _tasks[top & _mask].load(std::memory_order_relaxed);
+        if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            lost = true;
+            return _empty;
+        }
+        return task;
+    }
+
+    // Any thread: tasks held, possibly stale; never below the true count when called by the owner
+    size_t Size() const {
+        int64_t bottom = _bottom.load(std::memory_order_acquire);
+        int64_t top = _top.load(std::memory_order_acquire);
+        return bottom > top ? static_cast<size_t>(bottom - top) : 0;
+    }
+
+private:
+    alignas(64) std::atomic<int64_t> _top;
+    alignas(64) std::atomic<int64_t> _bottom;
+    std::unique_ptr<std::atomic<size_t>[]> _tasks;
+    size_t _mask;
+};
@@ -184,6 +184,7 @@ num_threads : 1
 dist_seed : {dist_seed}
 num_serial_OoO_execs : {exec_type}
 dist_params_file : {params_file}
+itl_shared : on
 """
 
     base_name = get_base_filename(config, dist_seed, params_config, hop_radius)
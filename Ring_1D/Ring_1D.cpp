@@ -14,8 +14,9 @@ Ring_1D::Ring_1D(size_t ringSize,
                  size_t numThreads, size_t distSeed,
                  int numSerialOoO_Execs,
                  std::string traceFolderName,
-                 std::string distParamsFile)
-: OoO_SimModel(maxSimTime, numThreads, distSeed, numSerialOoO_Execs, traceFolderName),
+                 std::string distParamsFile,
+                 const OoO_SimOptions& options)
+: OoO_SimModel(maxSimTime, numThreads, distSeed, numSerialOoO_Execs, traceFolderName, options),
 _ringSize(ringSize),
 _numServersPerNetworkNode(numServersPerNetworkNode),
 _maxNumArriveEvents(maxNumArriveEvents) {
@@ -40,7 +41,7 @@ _maxNumArriveEvents(maxNumArriveEvents) {
     << ", Max: " << _maxTransitTime << std::endl;
 
     // Create trace folder if needed
-    if (!fs::exists(_traceFolderName)) {
+    if (!_traceFolderName.empty() && !fs::exists(_traceFolderName)) {
         if (fs::create_directory(_traceFolderName)) {
             std::cout << "Folder '" << _traceFolderName << "' created successfully.\n";
         } else {
@@ -60,7 +61,9 @@ _maxNumArriveEvents(maxNumArriveEvents) {
     }
     std::string table_filename = "ITL_table_OoO_Ring_1D_network_size_" +
     std::to_string(_ringSize) + "_params_" + params + ".csv";
-    Init_OoO(table_filename);
+
+    // Vertices are numbered (position * 2 + type) around the ring
+    Init_OoO(table_filename, OoO_LatticeLayout{2, {_ringSize}});
 }
 
 void Ring_1D::BuildModel() {
@@ -143,14 +146,14 @@ void Ring_1D::CreateEdges() {
         size_t departIdx = GetVertexIndex(pos, 1);
 
         // Arrive -> Depart
-        _edges[arriveIdx].emplace_back(arriveIdx, departIdx, _minServiceTime);
+        _edges[arriveIdx].emplace_back(arriveIdx, departIdx, _minServiceTime, _serviceDelayClass);
 
         // Connect Depart to neighboring Arrive vertices with wrapping
         size_t clockwise_pos = WrapPosition(pos + 1);      // Clockwise neighbor
         size_t counter_pos = WrapPosition(pos + _ringSize - 1);  // Counterclockwise neighbor
 
-        _edges[departIdx].emplace_back(departIdx, GetVertexIndex(clockwise_pos, 0), _minTransitTime);   // Clockwise
-        _edges[departIdx].emplace_back(departIdx, GetVertexIndex(counter_pos, 0), _minTransitTime);     // Counterclockwise
+        _edges[departIdx].emplace_back(departIdx, GetVertexIndex(clockwise_pos, 0), _minTransitTime, _transitDelayClass);   // Clockwise
+        _edges[departIdx].emplace_back(departIdx, GetVertexIndex(counter_pos, 0), _minTransitTime, _transitDelayClass);     // Counterclockwise
     }
 }
 
@@ -165,9 +168,9 @@ void Ring_1D::InitEvents() {
     TriangularDist init_arrive_delays(_minIntraArrivalTime, _modeIntraArrivalTime, _maxIntraArrivalTime, _distSeed);
 
     for (size_t i = 0; i < _ringSize; i++) {
-        _initEvents.push_back(new OoO_Event(_arriveVertices[i],
-                                            init_arrive_delays.GenRV(),
-                                            nullptr));
+        _initEvents.Schedule(_arriveVertices[i].get(),
+                             init_arrive_delays.GenRV(),
+                             nullptr);
     }
 }
 
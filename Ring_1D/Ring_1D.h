@@ -18,7 +18,8 @@ public:
             size_t numThreads, size_t distSeed,
             int numSerialOoO_Execs,
             std::string traceFolderName,
-            std::string distParamsFile);
+            std::string distParamsFile,
+            const OoO_SimOptions& options);
 
     void PrintMeanPacketNetworkTime() const;
     virtual void PrintSVs() const override;
@@ -36,6 +37,10 @@ private:
     double _minServiceTime, _modeServiceTime, _maxServiceTime;
     double _minTransitTime, _modeTransitTime, _maxTransitTime;
 
+    // Edge delay classes, one per delay parameter
+    static constexpr int _serviceDelayClass = 0;
+    static constexpr int _transitDelayClass = 1;
+
     // Ring parameters
     const size_t _ringSize;
     const size_t _numServersPerNetworkNode;
@@ -38,7 +38,7 @@ void Ring_1D_Depart::IO_SVs(std::vector<std::vector<size_t>>& Is, std::vector<st
     Os.push_back(output_SV_indices);
 }
 
-void Ring_1D_Depart::Run(std::list<OoO_Event*>& newEvents, double simTime, std::shared_ptr<Entity> entity) {
+void Ring_1D_Depart::Run(OoO_EventSink& newEvents, double simTime, const std::shared_ptr<Entity>& entity) {
     std::shared_ptr<Ring_1D_Packet> packet = std::dynamic_pointer_cast<Ring_1D_Packet>(entity);
 
     // Evaluate Conditions
@@ -57,14 +57,14 @@ void Ring_1D_Depart::Run(std::list<OoO_Event*>& newEvents, double simTime, std::
 
     // Schedule New Events
     if (_packetInQueue) {
-        newEvents.push_back(new OoO_Event(shared_from_this(),
-                                          simTime + _serviceDelay->GenRV(),
-                                          queue_packet));
+        newEvents.Schedule(this,
+                           simTime + _serviceDelay->GenRV(),
+                           queue_packet);
     }
 
-    newEvents.push_back(new OoO_Event(_arriveVertices.at(dest_dir),
-                                      simTime + _transitDelay->GenRV(),
-                                      packet));
+    newEvents.Schedule(_arriveVertices.at(dest_dir).get(),
+                       simTime + _transitDelay->GenRV(),
+                       packet);
 
     // Trace
     std::string trace_string = std::to_string(simTime) + ", " + std::to_string(_packetQueueSV.get());
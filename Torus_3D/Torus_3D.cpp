@@ -14,8 +14,9 @@ Torus_3D::Torus_3D(size_t gridSizeX, size_t gridSizeY, size_t gridSizeZ,
                    size_t numThreads, size_t distSeed,
                    int numSerialOoO_Execs,
                    std::string traceFolderName,
-                   std::string distParamsFile)
-    : OoO_SimModel(maxSimTime, numThreads, distSeed, numSerialOoO_Execs, traceFolderName),
+                   std::string distParamsFile,
+                   const OoO_SimOptions& options)
+    : OoO_SimModel(maxSimTime, numThreads, distSeed, numSerialOoO_Execs, traceFolderName, options),
       _gridSizeX(gridSizeX), _gridSizeY(gridSizeY), _gridSizeZ(gridSizeZ),
       _hopRadius(hopRadius), _numServersPerNetworkNode(numServersPerNetworkNode),
       _maxNumArriveEvents(maxNumArriveEvents) {
@@ -40,7 +41,7 @@ Torus_3D::Torus_3D(size_t gridSizeX, size_t gridSizeY, size_t gridSizeZ,
     << ", Max: " << _maxTransitTime << std::endl;
 
     // Create trace folder if needed
-    if (!fs::exists(_traceFolderName)) {
+    if (!_traceFolderName.empty() && !fs::exists(_traceFolderName)) {
         if (fs::create_directory(_traceFolderName)) {
             std::cout << "Folder '" << _traceFolderName << "' created successfully.\n";
         } else {
@@ -64,7 +65,9 @@ Torus_3D::Torus_3D(size_t gridSizeX, size_t gridSizeY, size_t gridSizeZ,
                                 std::to_string(_gridSizeZ) + "_hops_" +
                                 std::to_string(_hopRadius) + "_params_" +
                                 params + ".csv";
-    Init_OoO(table_filename);
+
+    // Vertices are numbered (node * 2 + type) with node = x + X * (y + Y * z)
+    Init_OoO(table_filename, OoO_LatticeLayout{2, {_gridSizeX, _gridSizeY, _gridSizeZ}});
 }
 
 size_t Torus_3D::WrapCoordinate(size_t coord, size_t size) const {
@@ -283,7 +286,7 @@ void Torus_3D::CreateEdges() {
                 size_t departIdx = GetVertexIndex(x, y, z, 1);
 
                 // Arrive -> Depart
-                _edges[arriveIdx].emplace_back(arriveIdx, departIdx, _minServiceTime);
+                _edges[arriveIdx].emplace_back(arriveIdx, departIdx, _minServiceTime, _serviceDelayClass);
 
                 // Calculate wrapped indices
                 size_t west_x = WrapCoordinate(x - 1, _gridSizeX);
@@ -294,12 +297,12 @@ void Torus_3D::CreateEdges() {
                 size_t up_z = WrapCoordinate(z + 1, _gridSizeZ);
 
                 // Connect Depart to neighboring Arrive vertices (with wrapping)
-                _edges[departIdx].emplace_back(departIdx, GetVertexIndex(west_x, y, z, 0), _minTransitTime);     // West
-                _edges[departIdx].emplace_back(departIdx, GetVertexIndex(east_x, y, z, 0), _minTransitTime);     // East
-                _edges[departIdx].emplace_back(departIdx, GetVertexIndex(x, north_y, z, 0), _minTransitTime);    // North
-                _edges[departIdx].emplace_back(departIdx, GetVertexIndex(x, south_y, z, 0), _minTransitTime);    // South
-                _edges[departIdx].emplace_back(departIdx, GetVertexIndex(x, y, down_z, 0), _minTransitTime);     // Down
-                _edges[departIdx].emplace_back(departIdx, GetVertexIndex(x, y, up_z, 0), _minTransitTime);       // Up
+                _edges[departIdx].emplace_back(departIdx, GetVertexIndex(west_x, y, z, 0), _minTransitTime, _transitDelayClass);     // West
+                _edges[departIdx].emplace_back(departIdx, GetVertexIndex(east_x, y, z, 0), _minTransitTime, _transitDelayClass);     // East
+                _edges[departIdx].emplace_back(departIdx, GetVertexIndex(x, north_y, z, 0), _minTransitTime, _transitDelayClass);    // North
+                _edges[departIdx].emplace_back(departIdx, GetVertexIndex(x, south_y, z, 0), _minTransitTime, _transitDelayClass);    // South
+                _edges[departIdx].emplace_back(departIdx, GetVertexIndex(x, y, down_z, 0), _minTransitTime, _transitDelayClass);     // Down
+                _edges[departIdx].emplace_back(departIdx, GetVertexIndex(x, y, up_z, 0), _minTransitTime, _transitDelayClass);       // Up
             }
         }
     }
@@ -318,9 +321,9 @@ void Torus_3D::InitEvents() {
     size_t total_nodes = _gridSizeX * _gridSizeY * _gridSizeZ;
 
     for (size_t i = 0; i < total_nodes; i++) {
-        _initEvents.push_back(new OoO_Event(_arriveVertices[i],
-                                            init_arrive_delays.GenRV(),
-                                            nullptr));
+        _initEvents.Schedule(_arriveVertices[i].get(),
+                             init_arrive_delays.GenRV(),
+                             nullptr);
     }
 }
 
@@ -66,7 +66,7 @@ void Torus_3D_Arrive::IO_SVs(std::vector<std::vector<size_t>>& Is, std::vector<s
     Os.push_back(output_SV_indices);
 }
 
-void Torus_3D_Arrive::Run(std::list<OoO_Event*>& newEvents, double simTime, std::shared_ptr<Entity> entity) {
+void Torus_3D_Arrive::Run(OoO_EventSink& newEvents, double simTime, const std::shared_ptr<Entity>& entity) {
     std::shared_ptr<Torus_3D_Packet> packet = std::dynamic_pointer_cast<Torus_3D_Packet>(entity);
 
     // Evaluate Conditions
@@ -115,15 +115,15 @@ void Torus_3D_Arrive::Run(std::list<OoO_Event*>& newEvents, double simTime, std:
 
     // Schedule New Events
     if (!_atDestination && _serverAvailable) {
-        newEvents.push_back(new OoO_Event(_departVertex,
-                                         simTime + _serviceDelay->GenRV(),
-                                         packet));
+        newEvents.Schedule(_departVertex.get(),
+                          simTime + _serviceDelay->GenRV(),
+                          packet);
     }
 
     if (_intraArrival && ++_numIntraArriveEvents < _maxNumIntraArriveEvents) {
-        newEvents.push_back(new OoO_Event(shared_from_this(),
-                                         simTime + _intraArrivalDelay->GenRV(),
-                                         nullptr));
+        newEvents.Schedule(this,
+                          simTime + _intraArrivalDelay->GenRV(),
+                          nullptr);
     }
 
     // Trace
@@ -79,7 +79,7 @@ void Torus_3D_Depart::PrintNeighborInfo() const {
     printf("==============================\n\n");
 }
 
-void Torus_3D_Depart::Run(std::list<OoO_Event*>& newEvents, double simTime, std::shared_ptr<Entity> entity) {
+void Torus_3D_Depart::Run(OoO_EventSink& newEvents, double simTime, const std::shared_ptr<Entity>& entity) {
     std::shared_ptr<Torus_3D_Packet> packet = std::dynamic_pointer_cast<Torus_3D_Packet>(entity);
 
     // Evaluate Conditions
@@ -283,14 +283,14 @@ void Torus_3D_Depart::Run(std::list<OoO_Event*>& newEvents, double simTime, std:
 
     // Schedule New Events
     if (_packetInQueue) {
-        newEvents.push_back(new OoO_Event(shared_from_this(),
-                                          simTime + _serviceDelay->GenRV(),
-                                          queue_packet));
+        newEvents.Schedule(this,
+                           simTime + _serviceDelay->GenRV(),
+                           queue_packet);
     }
 
-    newEvents.push_back(new OoO_Event(_arriveVertices.at(dest_dir),
-                                      simTime + _transitDelay->GenRV(),
-                                      packet));
+    newEvents.Schedule(_arriveVertices.at(dest_dir).get(),
+                       simTime + _transitDelay->GenRV(),
+                       packet);
 
     // Trace
     std::string trace_string = std::to_string(simTime) + ", ";
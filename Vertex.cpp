@@ -4,22 +4,26 @@
 #include <iostream>
 #include <fstream>
 #include <cmath>
+#include <algorithm>
 
 int Vertex::_numVertices = 0;
 
 Vertex::Vertex(std::string vertexName, int extraWork, int distSeed, std::string traceFolderName, std::string traceFileHeading)
 : _vertexIndex(_numVertices++), _vertexName(vertexName), _extraWork(extraWork), _distSeed(distSeed + _vertexIndex), _traceFolderName(traceFolderName), _numExecutions(0)
 {
-    std::string file_vertex_name = _vertexName;
-    std::replace(file_vertex_name.begin(), file_vertex_name.end(), ' ', '_');
-    _traceFilePath = _traceFolderName + "/" + file_vertex_name + ".txt";
-    _traceFile.open(_traceFilePath);
-    if (_traceFile.is_open()) {
-        _traceFile << traceFileHeading << std::endl;
-    } else {
-        std::cerr << "Error opening trace file! Path: " << _traceFilePath << std::endl;
+    // No trace folder when only the model structure is needed
+    if (!_traceFolderName.empty()) {
+        std::string file_vertex_name = _vertexName;
+        std::replace(file_vertex_name.begin(), file_vertex_name.end(), ' ', '_');
+        _traceFilePath = _traceFolderName + "/" + file_vertex_name + ".txt";
+        _traceFile.open(_traceFilePath);
+        if (_traceFile.is_open()) {
+            _traceFile << traceFileHeading << std::endl;
+        } else {
+            std::cerr << "Error opening trace file! Path: " << _traceFilePath << std::endl;
+        }
+        _traceFile.close();
     }
-    _traceFile.close();
 
     if (_extraWork < 0) {
         if (-1 == _extraWork) _workDist = std::make_unique<ExpoDist>(2, _distSeed);
@@ -81,6 +85,6 @@ void Vertex::WriteToTrace(std::string traceSnapshot) {
 
 
 
-Edge::Edge(size_t origVertexIndex, size_t termVertexIndex, const float& minDist)
-:_origVertexIndex(origVertexIndex), _termVertexIndex(termVertexIndex), _minDist(minDist)
+Edge::Edge(size_t origVertexIndex, size_t termVertexIndex, const float& minDist, int delayClass)
+:_origVertexIndex(origVertexIndex), _termVertexIndex(termVertexIndex), _minDist(minDist), _delayClass(delayClass)
 {}
@@ -7,6 +7,7 @@
 #include <fstream>
 
 class OoO_Event;
+class OoO_EventSink;
 class Edge;
 class Entity;
 class ExpoDist;
@@ -15,7 +16,7 @@ class Vertex {
 public:
     Vertex(std::string vertexName, int extraWork, int distSeed, std::string traceFolderName, std::string traceFileHeading);
     virtual void IO_SVs(std::vector<std::vector<size_t>>& Is, std::vector<std::vector<size_t>>& Os) = 0;
-    virtual void Run(std::list<OoO_Event*>& newEvents, double simTime, std::shared_ptr<Entity> entity) = 0;
+    virtual void Run(OoO_EventSink& newEvents, double simTime, const std::shared_ptr<Entity>& entity) = 0;
     int ExtraWork();
     static int getNumVertices()  { return _numVertices; }
     int getVertexIndex() const  { return _vertexIndex; }
@@ -42,12 +43,17 @@ private:
 
 class Edge {
 public:
-    Edge(size_t origVertexIndex, size_t termVertexIndex, const float& minDist);
+    static constexpr int _noDelayClass = -1;
+
+    // Edges whose minimum delay comes from the same model parameter share a delay class
+    Edge(size_t origVertexIndex, size_t termVertexIndex, const float& minDist, int delayClass = _noDelayClass);
     size_t getOrigVertexIndex() const  { return _origVertexIndex; }
     size_t getTermVertexIndex() const  { return _termVertexIndex; }
     float getMinDist() const  { return _minDist; }
+    int getDelayClass() const  { return _delayClass; }
 private:
     const size_t _origVertexIndex;
     const size_t _termVertexIndex;
     const float _minDist;
+    const int _delayClass;
 };